@@ -14,6 +14,7 @@
 #include <vector>
 
 #include <mata/simlib/util/binary_relation.hh>
+#include <mata/simlib/util/partition_relation.hh>
 #include <mata/simlib/util/smart_set.hh>
 
 
@@ -140,6 +141,24 @@ public:
 		size_t   outputSize);
 
 	Util::BinaryRelation compute_simulation();
+
+	/**
+	 * @brief  Computes the simulation as a partition-relation pair
+	 *
+	 * Unlike @ref compute_simulation(), the result is never expanded into a
+	 * dense matrix over the states.
+	 *
+	 * @param[in]  partition   The initial partition
+	 * @param[in]  relation    The initial relation on blocks of @p partition
+	 * @param[in]  outputSize  Only states smaller than @p outputSize are kept in the result
+	 */
+	Util::PartitionRelation compute_simulation_partition(
+		const std::vector<std::vector<size_t>>&   partition,
+		const Util::BinaryRelation&               relation,
+		size_t                                    outputSize
+	);
+
+	Util::PartitionRelation compute_simulation_partition();
 };
 
 #endif
@@ -0,0 +1,304 @@
+/*****************************************************************************
+ *  Simlib
+ *
+ *  Description:
+ *    Partition-relation pair: a preorder stored as a partition of elements
+ *    into equivalence classes and a sparse relation on the classes.
+ *
+ *****************************************************************************/
+
+#ifndef _SIMLIB_PARTITION_RELATION_HH_
+#define _SIMLIB_PARTITION_RELATION_HH_
+
+#include <mata/simlib/util/binary_relation.hh>
+
+// Standard library headers
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cassert>
+
+namespace Simlib
+{
+	namespace Util
+	{
+		class PartitionRelation;
+	}
+}
+
+
+/**
+ * @brief  A preorder in the form of a partition-relation pair
+ *
+ * Elements are partitioned into blocks of mutually related elements and the
+ * preorder is kept only on the blocks, each block storing a sorted list of
+ * the blocks it is related to. Compared to @ref BinaryRelation, the memory
+ * needed is linear in the number of elements plus the number of related
+ * pairs of blocks, which makes it usable for relations over large sets.
+ *
+ * Blocks are numbered canonically by their heads (the smallest element of
+ * each block), hence two partition-relation pairs representing the same
+ * preorder compare equal.
+ */
+class Simlib::Util::PartitionRelation
+{
+	/// Block of each element.
+	std::vector<size_t> blockOf_;
+	/// The smallest element of each block.
+	std::vector<size_t> heads_;
+	/// For each block, the sorted blocks it is related to.
+	std::vector<std::vector<size_t>> images_;
+
+	static size_t find(std::vector<size_t>& parent, size_t x)
+	{
+		while (parent[x] != x)
+		{
+			parent[x] = parent[parent[x]];
+			x = parent[x];
+		}
+
+		return x;
+	}
+
+	void normalize(
+		const std::vector<size_t>&                 blockOf,
+		const std::vector<std::vector<size_t>>&    images)
+	{
+		const size_t UNDEF = static_cast<size_t>(-1);
+
+		std::vector<std::vector<size_t>> sortedImages(images);
+		for (auto& row : sortedImages)
+		{
+			std::sort(row.begin(), row.end());
+		}
+
+		// merge mutually related blocks
+		std::vector<size_t> parent(images.size());
+		std::iota(parent.begin(), parent.end(), 0);
+		for (size_t b = 0; b < sortedImages.size(); ++b)
+		{
+			for (size_t c : sortedImages[b])
+			{
+				if (c != b && std::binary_search(sortedImages[c].begin(), sortedImages[c].end(), b))
+				{
+					const size_t rb = find(parent, b);
+					const size_t rc = find(parent, c);
+					if (rb != rc) { parent[std::max(rb, rc)] = std::min(rb, rc); }
+				}
+			}
+		}
+
+		// number the (nonempty) blocks by their heads
+		std::vector<size_t> newIndex(images.size(), UNDEF);
+		blockOf_.resize(blockOf.size());
+		heads_.clear();
+		for (size_t i = 0; i < blockOf.size(); ++i)
+		{
+			assert(blockOf[i] < images.size());
+			const size_t root = find(parent, blockOf[i]);
+			if (UNDEF == newIndex[root])
+			{
+				newIndex[root] = heads_.size();
+				heads_.push_back(i);
+			}
+
+			blockOf_[i] = newIndex[root];
+		}
+
+		images_.assign(heads_.size(), std::vector<size_t>());
+		for (size_t b = 0; b < sortedImages.size(); ++b)
+		{
+			const size_t block = newIndex[find(parent, b)];
+			if (UNDEF == block)
+			{	// the block contains no element
+				continue;
+			}
+
+			for (size_t c : sortedImages[b])
+			{
+				const size_t image = newIndex[find(parent, c)];
+				if (UNDEF != image)
+				{
+					images_[block].push_back(image);
+				}
+			}
+		}
+
+		for (auto& row : images_)
+		{
+			std::sort(row.begin(), row.end());
+			row.erase(std::unique(row.begin(), row.end()), row.end());
+		}
+	}
+
+public:
+
+	PartitionRelation() :
+		blockOf_(),
+		heads_(),
+		images_()
+	{ }
+
+	/**
+	 * @brief  Constructs the relation from a partition and a relation on its blocks
+	 *
+	 * Blocks whose images contain each other are merged, empty blocks are
+	 * dropped and the remaining blocks are renumbered canonically.
+	 *
+	 * @param[in]  blockOf  Block of each element
+	 * @param[in]  images   For each block, the blocks it is related to
+	 */
+	PartitionRelation(
+		const std::vector<size_t>&                 blockOf,
+		const std::vector<std::vector<size_t>>&    images) :
+		blockOf_(),
+		heads_(),
+		images_()
+	{
+		this->normalize(blockOf, images);
+	}
+
+	/**
+	 * @brief  Compresses a (dense) preorder
+	 *
+	 * @param[in]  relation  The relation to compress, needs to be a preorder
+	 */
+	explicit PartitionRelation(const BinaryRelation& relation) :
+		blockOf_(),
+		heads_(),
+		images_()
+	{
+		std::vector<size_t> index;
+		std::vector<size_t> head;
+		relation.build_equivalence_classes(index, head);
+
+		std::vector<std::vector<size_t>> images(head.size());
+		for (size_t b = 0; b < head.size(); ++b)
+		{
+			for (size_t c = 0; c < head.size(); ++c)
+			{
+				if (relation.get(head[b], head[c]))
+				{
+					images[b].push_back(c);
+				}
+			}
+		}
+
+		this->normalize(index, images);
+	}
+
+	/// Number of elements.
+	size_t size() const { return blockOf_.size(); }
+
+	/// Number of blocks of mutually related elements.
+	size_t blocks() const { return heads_.size(); }
+
+	size_t block_of(size_t element) const
+	{
+		assert(element < blockOf_.size());
+
+		return blockOf_[element];
+	}
+
+	/// The smallest element of the block @p block.
+	size_t head(size_t block) const
+	{
+		assert(block < heads_.size());
+
+		return heads_[block];
+	}
+
+	/// The sorted blocks related to the block @p block.
+	const std::vector<size_t>& images(size_t block) const
+	{
+		assert(block < images_.size());
+
+		return images_[block];
+	}
+
+	bool get(size_t r, size_t c) const
+	{
+		const std::vector<size_t>& row = this->images(this->block_of(r));
+
+		return std::binary_search(row.begin(), row.end(), this->block_of(c));
+	}
+
+	bool sym(size_t r, size_t c) const
+	{
+		return this->block_of(r) == this->block_of(c);
+	}
+
+	/// Number of related pairs of blocks.
+	size_t block_pairs() const
+	{
+		size_t result = 0;
+		for (const auto& row : images_)
+		{
+			result += row.size();
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief  Gets the projection of elements to their representatives
+	 *
+	 * Every element is mapped to the smallest element of its block, which
+	 * matches @ref BinaryRelation::get_quotient_projection() on the symmetric
+	 * restriction of the same relation.
+	 *
+	 * @param[out]  quotProj  The vector mapping elements to their
+	 *                        representatives in the quotient set
+	 */
+	void get_quotient_projection(std::vector<size_t>& quotProj) const
+	{
+		quotProj.resize(blockOf_.size());
+		for (size_t i = 0; i < blockOf_.size(); ++i)
+		{
+			quotProj[i] = heads_[blockOf_[i]];
+		}
+	}
+
+	/**
+	 * @brief  Expands the relation into a dense binary relation
+	 *
+	 * @param[out]  result  The dense relation
+	 */
+	void build_binary_relation(BinaryRelation& result) const
+	{
+		result.resize(this->size());
+		result.reset(false);
+
+		std::vector<std::vector<size_t>> members(heads_.size());
+		for (size_t i = 0; i < blockOf_.size(); ++i)
+		{
+			members[blockOf_[i]].push_back(i);
+		}
+
+		for (size_t b = 0; b < images_.size(); ++b)
+		{
+			for (size_t c : images_[b])
+			{
+				for (size_t r : members[b])
+				{
+					for (size_t s : members[c])
+					{
+						result.set(r, s, true);
+					}
+				}
+			}
+		}
+	}
+
+	bool operator==(const PartitionRelation& rhs) const
+	{
+		return blockOf_ == rhs.blockOf_ && images_ == rhs.images_;
+	}
+
+	bool operator!=(const PartitionRelation& rhs) const
+	{
+		return !(*this == rhs);
+	}
+};
+
+#endif
@@ -30,6 +30,7 @@
 
 
 using Simlib::Util::BinaryRelation;
+using Simlib::Util::PartitionRelation;
 using Simlib::Util::SplittingRelation;
 using Simlib::Util::SmartSet;
 using Simlib::Util::CachingAllocator;
@@ -839,6 +840,42 @@ public:
 		}
 	}
 
+	void build_result(
+		PartitionRelation&    result,
+		size_t                size) const
+	{
+		std::vector<size_t> blockOf(size);
+		std::vector<std::vector<size_t>> images(this->partition_.size());
+
+		for (size_t i = 0; i < this->partition_.size(); ++i)
+		{
+			auto elem = this->partition_[i]->states_;
+
+			do
+			{
+				assert(elem);
+
+				if (elem->index_ < size)
+				{
+					blockOf[elem->index_] = i;
+				}
+
+				elem = elem->next_;
+
+			} while (elem != this->partition_[i]->states_);
+		}
+
+		for (size_t i = 0; i < this->relation_.size(); ++i)
+		{
+			for (auto j : const_cast<SplittingRelation*>(&this->relation_)->row(i))
+			{
+				images[i].push_back(j);
+			}
+		}
+
+		result = PartitionRelation(blockOf, images);
+	}
+
 	friend std::ostream& operator<<(
 		std::ostream&              os,
 		const SimulationEngine&    engine)
@@ -903,6 +940,44 @@ BinaryRelation Simlib::ExplicitLTS::compute_simulation()
 }
 
 
+PartitionRelation Simlib::ExplicitLTS::compute_simulation_partition(
+	const std::vector<std::vector<size_t>>&   partition,
+	const BinaryRelation&                     relation,
+	size_t                                    outputSize)
+{
+	if (0 == outputSize)
+	{
+		return PartitionRelation{};
+	}
+
+	SimulationEngine engine(*this);
+
+	engine.init(partition, relation);
+	engine.run();
+
+	PartitionRelation result;
+
+	engine.build_result(result, outputSize);
+
+	return result;
+}
+
+
+PartitionRelation Simlib::ExplicitLTS::compute_simulation_partition()
+{
+	std::vector<std::vector<size_t>> partition(1);
+
+	for (size_t i = 0; i < this->states_; ++i)
+	{
+		partition[0].push_back(i);
+	}
+
+	return this->compute_simulation_partition(
+		partition, Util::BinaryRelation(1, true), this->states_
+	);
+}
+
+
 void Simlib::ExplicitLTS::add_transition(size_t q, size_t a, size_t r) {
 	if (!symbol_map.contains(a)) { symbol_map[a] = symbol_map.size(); };
 	a = symbol_map[a];
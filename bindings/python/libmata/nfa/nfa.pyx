@@ -699,6 +699,9 @@ cdef class Nfa:
     def post_of(self, vector[State] states, Symbol symbol):
         """Returns sets of reachable states from set of states through a symbol
 
+        The reachable states are closed under epsilon transitions (transitions over symbols greater than or equal to
+        epsilon), the input states are expected to be closed under them as well.
+
         :param StateSet states: set of states
         :param Symbol symbol: source symbol
         :return: set of reachable states
@@ -0,0 +1,56 @@
+/* context.hh -- Reusable scratch space of algorithms.
+ */
+
+#ifndef MATA_CONTEXT_HH_
+#define MATA_CONTEXT_HH_
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mata/nfa/nfa.hh"
+
+namespace mata {
+
+/**
+ * @brief Workspace owning the temporary data structures of algorithms, reused between calls.
+ *
+ * Algorithms taking an optional pointer to a context keep their temporaries in the context instead of allocating
+ *  them on every call, and the buffers keep their capacity for the next call. A context must not be used by several
+ *  algorithms at once: every thread should hold its own context.
+ */
+class Context {
+public:
+    /// Temporaries of nfa::algorithms::product().
+    struct ProductBuffers {
+        /// Product states of pairs of states, indexed by 'lhs_state * rhs_num_of_states + rhs_state'. All items are
+        ///  nfa::Limits::max_state between calls.
+        std::vector<nfa::State> matrix{};
+        /// States of the operands of each product state.
+        std::vector<nfa::State> product_to_lhs{};
+        std::vector<nfa::State> product_to_rhs{};
+        std::vector<nfa::State> worklist{};
+    };
+
+    /// Temporaries of nfa::determinize().
+    struct DeterminizationBuffers {
+        std::unordered_map<nfa::StateSet, nfa::State> subset_map{};
+        std::vector<std::pair<nfa::State, nfa::StateSet>> worklist{};
+    };
+
+    ProductBuffers product{};
+    DeterminizationBuffers determinization{};
+
+    Context() = default;
+    Context(const Context&) = delete;
+    Context(Context&&) = default;
+    Context& operator=(const Context&) = delete;
+    Context& operator=(Context&&) = default;
+
+    /// Release the memory held by the context.
+    void clear() { *this = Context{}; }
+}; // class Context.
+
+} // namespace mata.
+
+#endif // MATA_CONTEXT_HH_
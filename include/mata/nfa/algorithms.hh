@@ -6,6 +6,8 @@
 
 #include "nfa.hh"
 #include "mata/simlib/util/binary_relation.hh"
+#include "mata/simlib/util/partition_relation.hh"
+#include "mata/utils/worklist.hh"
 
 /**
  * Concrete NFA implementations of algorithms, such as complement, inclusion, or universality checking.
@@ -32,6 +34,19 @@ namespace mata::nfa::algorithms {
  */
 Nfa minimize_brzozowski(const Nfa& aut);
 
+/**
+ * Moore minimization of automata: round-based refinement of the partition of states of the trimmed deterministic
+ *  automaton by signatures (blocks of successors of states over all symbols).
+ *
+ * Signatures of each round are computed in parallel and hashed into new blocks in a sharded concurrent hash table.
+ *  Nondeterministic automata are determinized first. Missing transitions lead to an implicit sink state, which is
+ *  not part of the result.
+ * @param[in] aut Automaton to be minimized.
+ * @param[in] num_of_threads Number of threads to compute the rounds with. The result does not depend on it.
+ * @return Minimized automaton.
+ */
+Nfa minimize_moore(const Nfa& aut, size_t num_of_threads = 1);
+
 /**
  * Complement implemented by determization, adding sink state and making automaton complete. Then it adds final states
  *  which were non final in the original automaton.
@@ -65,6 +80,52 @@ Nfa complement_brzozowski(const Nfa& aut, const mata::utils::OrdVector<Symbol>&
  */
 bool is_included_naive(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr, Run* cex = nullptr);
 
+/**
+ * Inclusion implemented by a lazy version of the naive algorithm: pairs of a state of smaller and a macrostate of the
+ *  determinization of bigger are explored on demand, starting from the initial pairs, until a pair with a final state
+ *  of smaller and a non-final macrostate is found. Bigger is determinized only along the words read by smaller, and
+ *  neither the complement of bigger nor the product is built.
+ *
+ * Returns a shortest counterexample in @p cex. Symbols of smaller missing in bigger lead to the empty macrostate,
+ *  hence, @p alphabet is not needed.
+ */
+bool is_included_naive_lazy(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr,
+                            Run* cex = nullptr);
+
+/**
+ * Order in which antichain algorithms explore pairs of states and macrostates (or macrostates).
+ *
+ * DISTANCE explores first the items closest to a counterexample, which differs per algorithm:
+ * - inclusion (is_included_antichains(), is_included_antichains_parallel()): the pairs whose state of the smaller
+ *   automaton has the smallest distance to a final state of the smaller automaton, since a counterexample is a word
+ *   accepted by the smaller automaton;
+ * - universality (is_universal_antichains()): the macrostates whose states have the largest minimal distance to a
+ *   final state, since a counterexample is a word rejected by the automaton.
+ */
+enum class ExplorationOrder {
+    DFS, ///< Depth-first search.
+    BFS, ///< Breadth-first search, finds shortest counterexamples.
+    SMALLEST_MACROSTATE, ///< Smallest macrostates first, which tend to subsume the most others.
+    DISTANCE, ///< Closest to a counterexample first, see the per-algorithm meaning above.
+};
+
+/**
+ * @brief Parse an exploration order given as a value of the "exploration" key of a parameter map.
+ *
+ * @param[in] order "dfs", "bfs", "smallest", or "distance".
+ * @throws std::runtime_error Unknown exploration order.
+ */
+ExplorationOrder parse_exploration_order(const std::string& order);
+
+/// Order of the worklist implementing the exploration @p order.
+inline mata::utils::WorklistOrder get_worklist_order(const ExplorationOrder order) {
+    switch (order) {
+        case ExplorationOrder::DFS: return mata::utils::WorklistOrder::DFS;
+        case ExplorationOrder::BFS: return mata::utils::WorklistOrder::BFS;
+        default: return mata::utils::WorklistOrder::PRIORITY;
+    }
+}
+
 /**
  * Inclusion implemented by antichain algorithms.
  * @param[in] smaller Automaton which language should be included in the bigger one
@@ -76,6 +137,85 @@ bool is_included_naive(const Nfa& smaller, const Nfa& bigger, const Alphabet* al
  */
 bool is_included_antichains(const Nfa& smaller, const Nfa& bigger, const Alphabet*  alphabet = nullptr, Run* cex = nullptr);
 
+/**
+ * Inclusion implemented by antichain algorithms, exploring the pairs in the given @p order.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] order Order of exploration of the pairs.
+ * @param[out] cex A potential counterexample word which breaks inclusion
+ * @return True if smaller language is included in the bigger one.
+ */
+bool is_included_antichains(const Nfa& smaller, const Nfa& bigger, ExplorationOrder order, Run* cex = nullptr);
+
+/**
+ * Inclusion implemented by antichain algorithms, with the pairs of the smaller automaton states and macrostates
+ *  explored by multiple threads.
+ *
+ * Every thread has its own worklist in the given @p order and steals pairs from the worklists of other threads when
+ *  its own worklist is empty (see Worklist::steal()). The antichains of processed pairs are shared, locked by shards
+ *  of the states of the smaller automaton. All threads stop as soon as one of them finds a violation of the inclusion.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] num_of_threads Number of threads to use.
+ * @param[in] order Order of exploration of the pairs by each thread.
+ * @param[out] cex A potential counterexample word which breaks inclusion
+ * @return True if smaller language is included in the bigger one.
+ */
+bool is_included_antichains_parallel(const Nfa& smaller, const Nfa& bigger, size_t num_of_threads,
+                                     ExplorationOrder order = ExplorationOrder::DFS, Run* cex = nullptr);
+
+/**
+ * Inclusion implemented by antichain algorithms pruned by forward simulation (Abdulla et al., When Simulation Meets
+ *  Antichains, 2010).
+ *
+ * Forward simulation is computed on the disjoint union of both automata. Macrostates of @p bigger keep only states not
+ *  simulated by other states of the macrostate, a pair of a state of @p smaller and a macrostate is not explored when
+ *  the state is simulated by a state of the macrostate, and the antichain compares pairs up to simulation.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] alphabet Alphabet of both automata (not needed for antichain algorithm)
+ * @param[out] cex A potential counterexample word which breaks inclusion
+ * @return True if smaller language is included,
+ * i.e., if the final intersection of smaller complement of bigger is empty.
+ */
+bool is_included_antichains_sim(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr,
+                                Run* cex = nullptr);
+
+/**
+ * Inclusion implemented by bisimulation up to congruence (the HKC algorithm by Bonchi and Pous, Checking NFA
+ *  equivalence with bisimulations up to congruence, 2013), using that the language of @p smaller is included in the
+ *  language of @p bigger iff the union of both languages equals the language of @p bigger.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] alphabet Alphabet of both automata (not needed for the algorithm)
+ * @param[out] cex A potential counterexample word which breaks inclusion (a shortest one)
+ * @return True if smaller language is included in the bigger one.
+ */
+bool is_included_congruence(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr,
+                            Run* cex = nullptr);
+
+/**
+ * Equivalence implemented by bisimulation up to congruence (the HKC algorithm). Unlike checking inclusion in both
+ *  directions, pairs of macrostates of both automata are explored only once.
+ * @param[in] lhs First automaton.
+ * @param[in] rhs Second automaton.
+ * @param[out] cex A shortest word accepted by exactly one of the automata, if they are not equivalent.
+ * @return True if the languages of @p lhs and @p rhs are equal.
+ */
+bool are_equivalent_congruence(const Nfa& lhs, const Nfa& rhs, Run* cex = nullptr);
+
+/**
+ * Equivalence of deterministic automata implemented by the algorithm of Hopcroft and Karp: pairs of states reached
+ *  over the same word are merged into classes of a union-find structure on the fly, and only pairs of states from
+ *  different classes are explored. Missing transitions lead to an implicit non-final sink state.
+ * @param[in] lhs First deterministic automaton.
+ * @param[in] rhs Second deterministic automaton.
+ * @param[out] cex A shortest word accepted by exactly one of the automata, if they are not equivalent.
+ * @return True if the languages of @p lhs and @p rhs are equal.
+ * @throws std::runtime_error Some of the automata is not deterministic.
+ */
+bool are_equivalent_hopcroft_karp(const Nfa& lhs, const Nfa& rhs, Run* cex = nullptr);
+
 /**
  * Universality check implemented by checking emptiness of complemented automaton
  * @param[in] aut Automaton which universality is checked
@@ -94,10 +234,44 @@ bool is_universal_naive(const Nfa& aut, const Alphabet& alphabet, Run* cex);
  */
 bool is_universal_antichains(const Nfa& aut, const Alphabet& alphabet, Run* cex);
 
+/**
+ * Universality checking based on subset construction with antichain, exploring macrostates in the given @p order.
+ * @param[in] aut Automaton which universality is checked
+ * @param[in] alphabet Alphabet of the automaton
+ * @param[in] order Order of exploration of the macrostates.
+ * @param[out] cex Counterexample word which eventually breaks the universality
+ * @return True if the automaton is universal, otherwise false.
+ */
+bool is_universal_antichains(const Nfa& aut, const Alphabet& alphabet, ExplorationOrder order, Run* cex);
+
+/**
+ * @brief Compute relation on states of @p aut.
+ *
+ * @param[in] aut Automaton to compute the relation for.
+ * @param[in] params Parameters of the relation:
+ * - "relation": "simulation",
+ * - "direction": "forward",
+ * - "threads" (optional): number of threads to compute the relation with ("0" for all hardware threads). The result is
+ *      the same as the one computed sequentially.
+ * @return The relation.
+ */
 Simlib::Util::BinaryRelation compute_relation(
         const Nfa& aut,
         const ParameterMap&  params = {{ "relation", "simulation"}, { "direction", "forward"}});
 
+/**
+ * @brief Compute relation on states of @p aut as a partition-relation pair.
+ *
+ * The states are partitioned into classes of mutually related states and the relation is stored only between the
+ *  classes, so the memory used is linear in the number of states plus the number of related pairs of classes.
+ * @param[in] aut Automaton to compute the relation for.
+ * @param[in] params Relation to compute, the same keys as for compute_relation().
+ * @return The relation in the compressed form.
+ */
+Simlib::Util::PartitionRelation compute_partition_relation(
+        const Nfa& aut,
+        const ParameterMap&  params = {{ "relation", "simulation"}, { "direction", "forward"}});
+
 /**
  * @brief Compute product of two NFAs, final condition is to be specified, with a possibility of using multiple epsilons.
  *
@@ -108,10 +282,12 @@ Simlib::Util::BinaryRelation compute_relation(
  * @param[out] prod_map Can be used to get the mapping of the pairs of the original states to product states.
  *   Mostly useless, it is only filled in and returned if !=nullptr, but the algorithm internally uses another data structures,
  *   because this one is too slow.
+ * @param[in,out] context Context to keep the temporaries of the construction in (see mata::Context).
  * @return NFA as a product of NFAs @p lhs and @p rhs with ε-transitions preserved.
  */
 Nfa product(const Nfa& lhs, const Nfa& rhs, const std::function<bool(State,State)> && final_condition,
-            const Symbol first_epsilon = EPSILON, std::unordered_map<std::pair<State,State>, State> *prod_map = nullptr);
+            const Symbol first_epsilon = EPSILON, std::unordered_map<std::pair<State,State>, State> *prod_map = nullptr,
+            Context* context = nullptr);
 
 /**
  * @brief Concatenate two NFAs.
@@ -6,6 +6,7 @@
 #include "nfa.hh"
 
 #include <filesystem>
+#include <unordered_set>
 
 
 /**
@@ -32,6 +33,89 @@ Nfa create_single_word_nfa(const std::vector<Symbol>& word);
  */
 Nfa create_single_word_nfa(const std::vector<std::string>& word, Alphabet* alphabet = nullptr);
 
+/**
+ * @brief Incremental construction of the minimal acyclic DFA accepting a finite set of words.
+ *
+ * Implements the incremental algorithms by Daciuk et al. (Incremental Construction of Minimal Acyclic Finite-State
+ *  Automata, 2000). States whose right languages are fully built are kept in a register of equivalent states, and a new
+ *  state equivalent to a registered one is immediately replaced by it. Hence, the automaton is kept minimal (up to the
+ *  states along the last added word) and the memory used is proportional to the size of the minimal automaton.
+ *
+ * For sorted words (the default), each word has to be lexicographically greater than or equal to the previous one and
+ *  only the states along the last added word are not in the register. Unsorted words are added by cloning the shared
+ *  (confluence) states along the common prefix of the new word with the automaton.
+ */
+class MinimalAcyclicDfaBuilder {
+public:
+    /**
+     * @param[in] sorted_words Whether the added words come in lexicographic order.
+     */
+    explicit MinimalAcyclicDfaBuilder(bool sorted_words = true);
+    MinimalAcyclicDfaBuilder(const MinimalAcyclicDfaBuilder&) = delete;
+    MinimalAcyclicDfaBuilder& operator=(const MinimalAcyclicDfaBuilder&) = delete;
+
+    /**
+     * Add @p word to the language of the automaton.
+     *
+     * @throws std::runtime_error The builder expects sorted words and @p word is smaller than the previous word.
+     */
+    void add_word(const Word& word);
+
+    /**
+     * Get the minimal DFA accepting the added words. State 0 is the initial state, the other states are numbered in
+     *  the breadth-first order. The builder is reset afterwards.
+     */
+    Nfa build();
+
+    /// Number of states of the automaton built so far.
+    size_t num_of_states() const { return states_.size() - free_states_.size(); }
+
+private:
+    struct DfaState {
+        bool is_final{ false };
+        std::vector<std::pair<Symbol, State>> transitions{}; ///< Sorted by symbols.
+        size_t in_degree{ 0 };
+    };
+
+    struct RegisterHash {
+        const std::vector<DfaState>* states;
+        size_t operator()(State state) const;
+    };
+
+    struct RegisterEqual {
+        const std::vector<DfaState>* states;
+        bool operator()(State lhs, State rhs) const;
+    };
+
+    bool sorted_words_;
+    std::vector<DfaState> states_{};
+    std::vector<State> free_states_{};
+    /// States with fully built right languages, no two of them equivalent.
+    std::unordered_set<State, RegisterHash, RegisterEqual> register_;
+    /// States along the previous word (sorted words only).
+    std::vector<State> path_{};
+    Word previous_word_{};
+
+    State new_state();
+    void delete_state(State state);
+    State* find_transition(State state, Symbol symbol);
+    void add_transition(State source, Symbol symbol, State target);
+    /// Replace @p state, the target of the transition over @p symbol from @p parent, by an equivalent registered state,
+    ///  or register @p state if there is no such state.
+    void replace_or_register(State parent, Symbol symbol, State state);
+    void add_sorted_word(const Word& word);
+    void add_unsorted_word(const Word& word);
+}; // class MinimalAcyclicDfaBuilder.
+
+/**
+ * Create the minimal DFA accepting exactly @p words (using MinimalAcyclicDfaBuilder).
+ *
+ * @param[in] words Words to accept.
+ * @param[in] sorted_words Whether @p words are sorted lexicographically. Sorted words are processed faster.
+ * @throws std::runtime_error @p sorted_words is set but @p words are not sorted.
+ */
+Nfa create_minimal_acyclic_dfa(const std::vector<Word>& words, bool sorted_words = true);
+
 /**
  * Create automaton accepting only epsilon string.
  */
@@ -8,7 +8,9 @@
 #include "mata/alphabet.hh"
 #include "mata/nfa/types.hh"
 
+#include <atomic>
 #include <iterator>
+#include <optional>
 
 namespace mata::nfa {
 
@@ -287,12 +289,34 @@ public:
     inline static const StatePost empty_state_post; // When posts[q] is not allocated, then delta[q] returns this.
 
     Delta(): state_posts_{} {}
-    Delta(const Delta& other) = default;
-    Delta(Delta&& other) = default;
-    explicit Delta(size_t n): state_posts_{ n } {}
+    /// A copy has no mutable references into it.
+    Delta(const Delta& other) : state_posts_{ other.state_posts_ }, version_{ other.version_ } {}
+    Delta(Delta&& other) noexcept
+        : state_posts_{ std::move(other.state_posts_) }, version_{ other.version_ },
+          tracked_content_{ std::move(other.tracked_content_) } {
+        other.tracked_content_.reset();
+        other.touch();
+    }
+    explicit Delta(size_t n): state_posts_{ n } { touch(); }
 
-    Delta& operator=(const Delta& other) = default;
-    Delta& operator=(Delta&& other) = default;
+    Delta& operator=(const Delta& other) {
+        if (this != &other) {
+            // The storage may be reused, hence the mutable references into this delta are kept.
+            state_posts_ = other.state_posts_;
+            version_ = other.version_;
+        }
+        return *this;
+    }
+    Delta& operator=(Delta&& other) noexcept {
+        if (this != &other) {
+            state_posts_ = std::move(other.state_posts_);
+            version_ = other.version_;
+            tracked_content_ = std::move(other.tracked_content_);
+            other.tracked_content_.reset();
+            other.touch();
+        }
+        return *this;
+    }
 
     bool operator==(const Delta& other) const;
 
@@ -341,20 +365,40 @@ public:
      * Use the constant 'state_post()' is possible. Or, to prevent the side effect from causing issues, one might want
      *  to make sure that posts of all states in the automaton are allocated, e.g., write an NFA method that allocate
      *  @c Delta for all states of the NFA.
+     * Modifications through the returned reference are tracked by version() until release_mutable_references() is
+     *  called.
      * @param state_from[in] Source state of a state post to access.
      * @return State post of @p src_state.
      */
     StatePost& mutable_state_post(State src_state);
 
+    /**
+     * @brief Declare that the references returned by mutable_state_post() and emplace_back() are not used anymore.
+     *
+     * While such references may be used to modify the delta, version() compares the content of the delta with a copy
+     *  taken when the version was assigned, which costs time linear in the size of the delta. Call this method when
+     *  the modifications through the references are finished to make version() constant-time again.
+     */
+    void release_mutable_references() {
+        if (tracked_content_) {
+            tracked_content_.reset();
+            touch();
+        }
+    }
+
     void defragment(const BoolVector& is_staying, const std::vector<State>& renaming);
 
     template <typename... Args>
     StatePost& emplace_back(Args&&... args) {
+        track_mutable_references();
 	// Forwarding the variadic template pack of arguments to the emplace_back() of the underlying container.
         return state_posts_.emplace_back(std::forward<Args>(args)...);
     }
 
-    void clear() { state_posts_.clear(); }
+    void clear() {
+        touch();
+        state_posts_.clear();
+    }
 
     /**
      * @brief Allocate state posts up to @p num_of_states states, creating empty @c StatePost for yet unallocated state
@@ -365,6 +409,7 @@ public:
      */
     void allocate(const size_t num_of_states) {
         assert(num_of_states >= this->num_of_states());
+        touch();
         state_posts_.resize(num_of_states);
     }
 
@@ -409,6 +454,7 @@ public:
      * @param post_vector Vector of posts to be appended.
      */
     void append(const std::vector<StatePost>& post_vector) {
+        touch();
         for(const StatePost& pst : post_vector) {
             this->state_posts_.push_back(pst);
         }
@@ -498,8 +544,47 @@ public:
      * @brief Get the maximum non-epsilon used symbol.
      */
     Symbol get_max_symbol() const;
+
+    /**
+     * @brief Get the version of the content of the delta.
+     *
+     * Every non-constant method, which may modify the delta, invalidates the version, and a new version unique among
+     *  all deltas is assigned on the next call of version(). Copies keep the version of the original. Hence, deltas with
+     *  equal versions have equal contents. Modifications through references returned by mutable_state_post() and
+     *  emplace_back() are detected by comparing the content with a copy until release_mutable_references() is called.
+     *  Assigning the version is not synchronized: concurrent calls on the same delta have to be guarded by the caller
+     *  (as Nfa does).
+     */
+    size_t version() const {
+        if (tracked_content_ && (version_ == INVALID_VERSION || !equals_tracked_content())) {
+            version_ = INVALID_VERSION;
+            *tracked_content_ = state_posts_;
+        }
+        if (version_ == INVALID_VERSION) { version_ = next_version_.fetch_add(1, std::memory_order_relaxed); }
+        return version_;
+    }
+
 private:
+    static constexpr size_t INVALID_VERSION{ 0 };
+
     std::vector<StatePost> state_posts_;
+    mutable size_t version_{ INVALID_VERSION };
+    inline static std::atomic<size_t> next_version_{ INVALID_VERSION + 1 };
+    /// Content of the delta of the version 'version_', present while references returned by mutable_state_post() and
+    ///  emplace_back() may be used to modify the delta.
+    mutable std::optional<std::vector<StatePost>> tracked_content_{};
+
+    /// Invalidate the version after a modification, a fresh one is assigned lazily by version().
+    void touch() { version_ = INVALID_VERSION; }
+
+    /// Check whether the state posts equal 'tracked_content_', including the targets of the symbol posts.
+    bool equals_tracked_content() const;
+
+    /// Invalidate the version before handing out a mutable reference, and track the modifications through it.
+    void track_mutable_references() {
+        touch();
+        if (!tracked_content_) { tracked_content_.emplace(); }
+    }
 }; // class Delta.
 
 /**
@@ -4,16 +4,15 @@
 #ifndef MATA_NFA_HH_
 #define MATA_NFA_HH_
 
-// Static data structures, such as search stack, in algorithms. Might have some effect on some algorithms (like
-//  fragile_revert).
-//#define _STATIC_STRUCTURES_
-
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <limits>
 #include <set>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -27,6 +26,7 @@
 #include "mata/parser/inter-aut.hh"
 #include "mata/utils/synchronized-iterator.hh"
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/scc.hh"
 #include "types.hh"
 #include "delta.hh"
 
@@ -41,6 +41,10 @@
  * Other algorithms are included in mata::nfa::Plumbing (simplified API for, e.g., binding)
  * and mata::nfa::algorithms (concrete implementations of algorithms, such as for complement).
  */
+namespace mata {
+class Context;
+} // namespace mata.
+
 namespace mata::nfa {
 
 /**
@@ -87,7 +91,9 @@ public:
 
     Nfa(Nfa&& other) noexcept
         : delta{ std::move(other.delta) }, initial{ std::move(other.initial) }, final{ std::move(other.final) },
-          alphabet{ other.alphabet }, attributes{ std::move(other.attributes) } { other.alphabet = nullptr; }
+          alphabet{ other.alphabet }, attributes{ std::move(other.attributes) }, cache_{ std::move(other.cache_) } {
+        other.alphabet = nullptr;
+    }
 
     Nfa& operator=(const Nfa& other) = default;
     Nfa& operator=(Nfa&& other) noexcept;
@@ -148,50 +154,56 @@ public:
     /**
      * @brief Get set of reachable states.
      *
-     * Reachable states are states accessible from any initial state.
+     * Reachable states are states accessible from any initial state. The states are searched breadth-first with
+     *  bitset frontiers, expanding each frontier in parallel when @p num_of_threads is greater than 1.
+     * @param[in] num_of_threads Number of threads to expand the frontiers with.
      * @return Set of reachable states.
-     * TODO: with the new get_useful_states, it might be useless now.
      */
-    StateSet get_reachable_states() const;
+    StateSet get_reachable_states(size_t num_of_threads = 1) const;
 
     /**
      * @brief Get set of terminating states.
      *
-     * Terminating states are states leading to any final state.
+     * Terminating states are states leading to any final state. The states are searched backward from the final
+     *  states over an index of predecessors, without constructing the reversed automaton.
+     * @param[in] num_of_threads Number of threads to expand the frontiers with.
      * @return Set of terminating states.
-     * TODO: with the new get_useful_states, it might be useless now.
      */
-    StateSet get_terminating_states() const;
+    StateSet get_terminating_states(size_t num_of_threads = 1) const;
 
     /**
-     * @brief Get the useful states using a modified Tarjan's algorithm. A state
-     * is useful if it is reachable from an initial state and can reach a final state.
+     * @brief Get the useful states. A state is useful if it is reachable from an initial state and can reach a final
+     *  state.
      *
+     * Reachable states are searched forward from the initial states, and the useful ones among them backward from the
+     *  final states (see get_reachable_states() and get_terminating_states()).
+     * The result is cached in the automaton until the automaton is modified (see Cache).
+     * @param[in] num_of_threads Number of threads to expand the frontiers with.
      * @return BoolVector Bool vector whose ith value is true iff the state i is useful.
      */
-    BoolVector get_useful_states() const;
+    BoolVector get_useful_states(size_t num_of_threads = 1) const;
 
     /**
-     * @brief Structure for storing callback functions (event handlers) utilizing 
-     * Tarjan's SCC discover algorithm.
+     * @brief Tarjan's SCC discover algorithm over the states reachable from the initial states.
+     *
+     * The hooks of @p visitor (see utils::SccVisitor) are resolved statically.
+     * @param[in,out] visitor Visitor deriving from utils::SccVisitor<State>.
+     * @return True iff the search was stopped by @p visitor.
      */
-    struct TarjanDiscoverCallback {
-        // event handler for the first-time state discovery
-        std::function<bool(State)> state_discover;
-        // event handler for SCC discovery (together with the whole Tarjan stack)
-        std::function<bool(const std::vector<State>&, const std::vector<State>&)> scc_discover;
-        // event handler for state in SCC discovery
-        std::function<void(State)> scc_state_discover;
-        // event handler for visiting of the state successors
-        std::function<void(State,State)> succ_state_discover;
-    };
+    template<class Visitor>
+    bool tarjan_scc_discover(Visitor& visitor) const {
+        return utils::tarjan_scc(num_of_states(), initial, [this](const State state) { return delta[state].moves(); },
+                                 visitor, [](const Move& move) { return move.target; });
+    }
 
     /**
-     * @brief Tarjan's SCC discover algorihm.
-     * 
-     * @param callback Callbacks class to instantiate callbacks for the Tarjan's algorithm.
+     * @brief Get the condensation of the automaton: the DAG of the SCCs of the states reachable from the initial
+     *  states, numbered in a topological order.
+     *
+     * Unreachable states are in the SCC utils::Condensation<State>::NO_SCC. The condensation is cached in the automaton
+     *  until the automaton is modified (see Cache).
      */
-    void tarjan_scc_discover(const TarjanDiscoverCallback& callback) const;
+    const utils::Condensation<State>& get_condensation() const;
 
     /**
      * @brief Remove inaccessible (unreachable) and not co-accessible (non-terminating) states in-place.
@@ -201,11 +213,29 @@ public:
      * the starting point of a path ending in a final state).
      *
      * @param[out] state_renaming Mapping of trimmed states to new states.
+     * @param[in] num_of_threads Number of threads to search for the useful states with (see get_useful_states()).
      * @return @c this after trimming.
      */
-    Nfa& trim(StateRenaming* state_renaming = nullptr);
+    Nfa& trim(StateRenaming* state_renaming = nullptr, size_t num_of_threads = 1);
+
+    /**
+     * @brief Get the lengths of the shortest paths from the initial states to each state.
+     *
+     * The distances are cached in the automaton until the automaton is modified (see Cache).
+     * @return Distances indexed by states, Limits::max_state for unreachable states. There is one more item than there
+     *  are states of the automaton.
+     */
+    const std::vector<State>& distances_from_initial() const;
 
-    std::vector<State> distances_from_initial() const;
+    /**
+     * @brief Get the lengths of the shortest paths from each state to the final states.
+     *
+     * The distances are computed backward from the final states over an index of predecessors, and they are cached in
+     *  the automaton until the automaton is modified (see Cache).
+     * @return Distances indexed by states, Limits::max_state for non-terminating states. There is one more item than
+     *  there are states of the automaton.
+     */
+    const std::vector<State>& distances_to_final() const;
 
     /**
      * Remove epsilon transitions from the automaton.
@@ -280,6 +310,13 @@ public:
     void print_to_mata(std::ostream &output) const;
 
     // TODO: Relict from VATA. What to do with inclusion/ universality/ this post function? Revise all of them.
+    /**
+     * Get the states reachable from @p states over @p symbol, closed under epsilon transitions (transitions over
+     *  symbols greater than or equal to EPSILON). @p states are expected to be closed under epsilon transitions.
+     *
+     * Earlier versions did not follow epsilon transitions and returned only the direct targets of @p symbol. Use
+     *  Delta::state_post() for the direct targets of a single state.
+     */
     StateSet post(const StateSet& states, const Symbol& symbol) const;
 
     /**
@@ -337,18 +374,27 @@ public:
      */
     void fill_alphabet(mata::OnTheFlyAlphabet& alphabet_to_fill) const;
 
-    /// Is the language of the automaton universal?
+    /**
+     * @brief Is the language of the automaton universal?
+     *
+     * @param[in] alphabet Alphabet to check the universality over.
+     * @param[out] cex Counterexample (a word not accepted by the automaton) if the language is not universal.
+     * @param[in] params Parameters of the check:
+     * - "algorithm": "naive", "antichains",
+     * - "exploration" (optional, "antichains" only): order of exploration of macrostates, "dfs" (default), "bfs",
+     *   "smallest" (smallest macrostates first), or "distance" (macrostates farthest from final states first).
+     */
     bool is_universal(const Alphabet& alphabet, Run* cex = nullptr,
                       const ParameterMap& params = {{ "algorithm", "antichains" }}) const;
     /// Is the language of the automaton universal?
     bool is_universal(const Alphabet& alphabet, const ParameterMap& params) const;
 
-    /// Checks whether a word is in the language of an automaton.
+    /// Checks whether a word is in the language of an automaton, following epsilon transitions on the way.
     bool is_in_lang(const Run& word) const;
-    /// Checks whether a word is in the language of an automaton.
+    /// Checks whether a word is in the language of an automaton, following epsilon transitions on the way.
     bool is_in_lang(const Word& word) { return is_in_lang(Run{ word, {} }); }
 
-    /// Checks whether the prefix of a string is in the language of an automaton
+    /// Checks whether the prefix of a string is in the language of an automaton, following epsilon transitions.
     bool is_prfx_in_lang(const Run& word) const;
 
     std::pair<Run, bool> get_word_for_path(const Run& run) const;
@@ -427,8 +473,220 @@ public:
      * @pre @c this is a deterministic automaton.
      */
     Nfa& complement_deterministic(const mata::utils::OrdVector<Symbol>& symbols, std::optional<State> sink_state = std::nullopt);
+
+private:
+    /**
+     * @brief Data derived from the automaton, computed on the first use and kept until the automaton is modified.
+     *
+     * The data are valid for the delta of the version 'delta_version' (see Delta::version()) and the initial and final
+     *  states 'initial' and 'final', which are checked on every access.
+     */
+    struct CachedData {
+        size_t delta_version{ 0 };
+        size_t num_of_states{ 0 };
+        std::vector<State> initial{};
+        std::vector<State> final{};
+        std::optional<std::vector<State>> distances_from_initial{};
+        std::optional<std::vector<State>> distances_to_final{};
+        std::optional<BoolVector> useful_states{};
+        std::optional<utils::Condensation<State>> condensation{};
+    };
+
+    /**
+     * @brief Cached data with a mutex, so that constant methods can be called concurrently on a shared automaton.
+     *
+     * Copies of a cache are empty, so that a copied automaton does not copy the data.
+     */
+    struct Cache {
+        std::mutex mutex{};
+        CachedData data{};
+
+        Cache() = default;
+        Cache(const Cache&) {}
+        Cache(Cache&& other) noexcept : data{ std::move(other.data) } {}
+        Cache& operator=(const Cache&) { data = CachedData{}; return *this; }
+        Cache& operator=(Cache&& other) noexcept { data = std::move(other.data); return *this; }
+    };
+
+    mutable Cache cache_{};
+
+    /**
+     * @brief Get the cached data, emptied if the automaton has been modified since the data were computed.
+     *
+     * The mutex of the cache has to be held.
+     */
+    CachedData& get_cache() const;
+
+    /// Get the cached data @p member, computed by @p compute if it is not cached yet.
+    template<class T, class Compute>
+    const T& get_cached(std::optional<T> CachedData::* member, const Compute& compute) const {
+        const std::lock_guard lock{ cache_.mutex };
+        std::optional<T>& data{ get_cache().*member };
+        if (!data.has_value()) { data = compute(); }
+        return *data;
+    }
 }; // struct Nfa.
 
+/**
+ * @brief Epsilon closures of states of an automaton, computed on the first use and memoized.
+ *
+ * Membership of words in an automaton with epsilon transitions (transitions over symbols greater than or equal to
+ *  @c first_epsilon) is checked without removing the epsilon transitions. Only the closures of the states reached
+ *  are computed. Trivial closures of states without epsilon transitions are not stored, the other closures are stored
+ *  one after another in a single vector. Keep the object to check several words against the same automaton.
+ *
+ * The automaton must not be modified while its closures are used.
+ */
+class EpsilonClosures {
+public:
+    explicit EpsilonClosures(const Nfa& aut, Symbol first_epsilon = EPSILON)
+        : aut_{ aut }, first_epsilon_{ first_epsilon } {}
+
+    /// Get the epsilon closure of @p states.
+    StateSet closure(const StateSet& states);
+    /// Get the states reachable from the (closed) @p states over @p symbol, closed under epsilon transitions.
+    StateSet post(const StateSet& states, Symbol symbol);
+    /// Check whether @p word is in the language of the automaton.
+    bool is_in_lang(const Word& word);
+    /// Check whether a prefix of @p word is in the language of the automaton.
+    bool is_prfx_in_lang(const Word& word);
+
+private:
+    const Nfa& aut_;
+    Symbol first_epsilon_;
+    /// Closure of a state 'q' with epsilon transitions is 'states_[ranges_[q].first]', ...,
+    ///  'states_[ranges_[q].second - 1]'. Allocated when the first closure is computed.
+    std::vector<std::pair<size_t, size_t>> ranges_{};
+    std::vector<State> states_{};
+    /// Temporaries of the computation of closures.
+    std::vector<State> collected_{};
+    std::vector<State> worklist_{};
+    /// States visited by the search for the closure number 'visited_[q]'.
+    std::vector<size_t> visited_{};
+    size_t num_of_searches_{ 0 };
+
+    bool has_epsilon(State state) const;
+    /// Append the closure of @p state to @p result (not sorted).
+    void append_closure(State state, std::vector<State>& result);
+    StateSet close(const std::vector<State>& states);
+}; // class EpsilonClosures.
+
+/**
+ * @brief Breadth-first or depth-first search over the states of automata, recording the path to every visited state.
+ *
+ * The visited states, the parent of each state, the symbol of the transition from the parent, and the distance from
+ *  the start of the search are kept in flat arrays indexed by states. The arrays (and the worklist) are allocated
+ *  once and reused by subsequent searches: starting a new search is constant-time, hence, keep the object to run
+ *  several searches.
+ */
+class Traversal {
+public:
+    enum class Order {
+        BFS, ///< States are visited in the order of their distance from the sources.
+        DFS,
+    };
+
+    /// Parent of the sources of the search.
+    static constexpr State NO_PARENT{ Limits::max_state };
+
+    /**
+     * @param[in] order Order of the search.
+     * @param[in] first_epsilon Symbols from @p first_epsilon on are epsilon symbols, which are skipped in the words
+     *  read off the paths (see word_to()).
+     */
+    explicit Traversal(const Order order = Order::BFS, const Symbol first_epsilon = EPSILON)
+        : order_{ order }, first_epsilon_{ first_epsilon } {}
+
+    /**
+     * @brief Search the states of @p aut reachable from @p sources.
+     *
+     * @p visit is called for every state when it is discovered (including the sources), when the path to the state
+     *  is already recorded. The search stops when @p visit returns true.
+     * @param[in] sources States to start the search from.
+     * @param[in] visit Function called with each discovered state, returning whether to stop the search.
+     * @return State at which the search was stopped, std::nullopt if all reachable states have been visited.
+     */
+    template<class Sources, class Visit>
+    std::optional<State> run(const Nfa& aut, const Sources& sources, Visit&& visit) {
+        start(aut.num_of_states());
+        for (const State source: sources) {
+            if (!discover(source, NO_PARENT, Symbol{ 0 }, 0)) { continue; }
+            if (visit(source)) { return source; }
+        }
+        while (true) {
+            State state;
+            if (order_ == Order::BFS) {
+                if (queue_head_ == discovered_.size()) { return std::nullopt; }
+                state = discovered_[queue_head_++];
+            } else {
+                if (stack_.empty()) { return std::nullopt; }
+                state = stack_.back();
+                stack_.pop_back();
+            }
+            const size_t target_depth{ depths_[state] + 1 };
+            for (const SymbolPost& symbol_post: aut.delta[state]) {
+                for (const State target: symbol_post.targets) {
+                    if (!discover(target, state, symbol_post.symbol, target_depth)) { continue; }
+                    if (visit(target)) { return target; }
+                }
+            }
+        }
+    }
+
+    /// Search the states reachable from @p sources without stopping (see run()).
+    template<class Sources>
+    void run(const Nfa& aut, const Sources& sources) { run(aut, sources, [](State) { return false; }); }
+
+    /// Whether @p state has been visited by the last search.
+    bool is_visited(const State state) const { return state < stamps_.size() && stamps_[state] == stamp_; }
+    /// Parent of the visited @p state, NO_PARENT for sources.
+    State parent(const State state) const { return parents_[state]; }
+    /// Symbol of the transition from the parent of the visited @p state.
+    Symbol parent_symbol(const State state) const { return parent_symbols_[state]; }
+    /// Length of the path from a source to the visited @p state.
+    size_t depth(const State state) const { return depths_[state]; }
+    /// States visited by the last search in the order of their discovery.
+    const std::vector<State>& visited_states() const { return discovered_; }
+
+    /// Get the path from a source to the visited @p state.
+    std::vector<State> path_to(State state) const;
+    /// Get the word read along the path from a source to the visited @p state, without epsilon symbols.
+    Word word_to(State state) const;
+    /// Get the symbols of the transitions along the path from a source to the visited @p state, including epsilon
+    ///  symbols, i.e., one symbol for every transition of path_to().
+    Word symbols_to(State state) const;
+
+private:
+    Order order_;
+    Symbol first_epsilon_;
+    /// State 'q' has been visited by the current search iff 'stamps_[q] == stamp_'.
+    std::vector<size_t> stamps_{};
+    size_t stamp_{ 0 };
+    std::vector<State> parents_{};
+    std::vector<Symbol> parent_symbols_{};
+    std::vector<size_t> depths_{};
+    /// Discovered states. States from 'queue_head_' on are the worklist of BFS.
+    std::vector<State> discovered_{};
+    size_t queue_head_{ 0 };
+    /// Worklist of DFS.
+    std::vector<State> stack_{};
+
+    /// Start a new search over an automaton with @p num_of_states states.
+    void start(size_t num_of_states);
+
+    /// Mark @p state as visited and record its path. Return false if @p state has already been visited.
+    bool discover(const State state, const State parent, const Symbol symbol, const size_t depth) {
+        if (stamps_[state] == stamp_) { return false; }
+        stamps_[state] = stamp_;
+        parents_[state] = parent;
+        parent_symbols_[state] = symbol;
+        depths_[state] = depth;
+        discovered_.push_back(state);
+        if (order_ == Order::DFS) { stack_.push_back(state); }
+        return true;
+    }
+}; // class Traversal.
+
 // Allow variadic number of arguments of the same type.
 //
 // Using parameter pack and variadic arguments.
@@ -498,10 +756,11 @@ Nfa union_nondet(const Nfa &lhs, const Nfa &rhs);
  * Preserves determinism.
  * @param[in] first_epsilon The first symbol to handle as an epsilon.
  * @param[out] prod_map Map mapping product states to the original states.
+ * @param[in,out] context Context to keep the temporaries of the construction in (see mata::Context).
  * @return Union by product construction of @p lhs and @p rhs.
  */
 Nfa union_product(const Nfa &lhs, const Nfa &rhs, Symbol first_epsilon = EPSILON,
-                  std::unordered_map<std::pair<State,State>,State> *prod_map = nullptr);
+                  std::unordered_map<std::pair<State,State>,State> *prod_map = nullptr, Context* context = nullptr);
 
 /**
  * @brief Compute a language difference as @p nfa_included \ @p nfa_excluded.
@@ -542,10 +801,12 @@ Nfa lang_difference(
  * @param[in] rhs Second NFA to compute intersection for.
  * @param[in] first_epsilon smallest epsilon. //TODO: this should eventually be taken from the alphabet as anything larger than the largest symbol?
  * @param[out] prod_map Mapping of pairs of the original states (lhs_state, rhs_state) to new product states (not used internally, allocated only when !=nullptr, expensive).
+ * @param[in,out] context Context to keep the temporaries of the construction in (see mata::Context).
  * @return NFA as a product of NFAs @p lhs and @p rhs with ε-transitions preserved.
  */
 Nfa intersection(const Nfa& lhs, const Nfa& rhs,
-                 const Symbol first_epsilon = EPSILON, std::unordered_map<std::pair<State, State>, State> *prod_map = nullptr);
+                 const Symbol first_epsilon = EPSILON, std::unordered_map<std::pair<State, State>, State> *prod_map = nullptr,
+                 Context* context = nullptr);
 
 /**
  * @brief Concatenate two NFAs.
@@ -603,7 +864,8 @@ Nfa complement(const Nfa& aut, const utils::OrdVector<Symbol>& symbols,
  *
  * @param[in] aut Automaton whose minimal version to compute.
  * @param[in] params Optional parameters to control the minimization algorithm:
- * - "algorithm": "brzozowski"
+ * - "algorithm": "brzozowski", "moore",
+ * - "threads": number of threads for the "moore" algorithm ("0" for all hardware threads).
  * @return Minimal deterministic automaton.
  */
 Nfa minimize(const Nfa &aut, const ParameterMap& params = { { "algorithm", "brzozowski" } });
@@ -617,12 +879,29 @@ Nfa minimize(const Nfa &aut, const ParameterMap& params = { { "algorithm", "brzo
  *  parameters are the determinized NFA constructed so far, the current macrostate, and the set of the original states
  *  corresponding to the macrostate. Return @c true if the determinization should continue, and @c false if the
  *  determinization should stop and return only the determinized NFA constructed so far.
+ * @param[in,out] context Context to keep the temporaries of the construction in (see mata::Context). Its subset map
+ *  is used when @p subset_map is not given.
  * @return Determinized automaton.
  * @todo: TODO: Add support for specifying first epsilon symbol and compute epsilon closure during determinization.
  */
 Nfa determinize(
     const Nfa& aut, std::unordered_map<StateSet, State> *subset_map = nullptr,
-    std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover = std::nullopt);
+    std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover = std::nullopt,
+    Context* context = nullptr);
+
+/**
+ * @brief Determinize the reversal of an automaton, and revert the result back.
+ *
+ * The subset construction runs over the PredecessorIndex of @p aut, and the transitions of the constructed DFA are
+ *  written reverted right into the state posts of the result, so neither the reversal of @p aut nor the reversal of
+ *  the constructed DFA is materialized. The result is isomorphic to 'revert(determinize(revert(aut)))' (the states
+ *  are numbered in the breadth-first order): an automaton accepting the language of @p aut whose reversal is
+ *  deterministic.
+ *
+ * @param[in] aut Automaton to determinize backward.
+ * @return Backward determinized automaton.
+ */
+Nfa determinize_backward(const Nfa& aut);
 
 /**
  * @brief Reduce the size of the automaton.
@@ -633,7 +912,9 @@ Nfa determinize(
  * - "algorithm": "simulation", "residual",
  *      and options to parametrize residual reduction, not utilized in simulation
  * - "type": "after", "with",
- * - "direction": "forward", "backward".
+ * - "direction": "forward", "backward",
+ * - "threads": number of threads used to compute the simulation ("0" for all hardware threads); when not set, the
+ *      simulation is computed sequentially. The result does not depend on the number of threads.
  * @return Reduced automaton.
  */
 Nfa reduce(const Nfa &aut, StateRenaming *state_renaming = nullptr,
@@ -647,7 +928,13 @@ Nfa reduce(const Nfa &aut, StateRenaming *state_renaming = nullptr,
  * @param[out] cex Counterexample for the inclusion.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "naive-lazy" (naive on the fly), "antichains", "antichains-sim" (antichains pruned by
+ *   simulation), "congruence" (bisimulation up to congruence) (Default: "antichains")
+ * - "threads" (optional, "antichains" only): number of threads to explore the antichains with ("0" for all hardware
+ *   threads).
+ * - "exploration" (optional, "antichains" only): order of exploration of pairs, "dfs" (default), "bfs", "smallest"
+ *   (smallest macrostates first), or "distance" (states of @p smaller closest to final states first). With "threads",
+ *   each thread explores its own pairs in this order.
  * @return True if @p smaller is included in @p bigger, false otherwise.
  */
 bool is_included(const Nfa& smaller, const Nfa& bigger, Run* cex, const Alphabet* alphabet = nullptr,
@@ -660,7 +947,13 @@ bool is_included(const Nfa& smaller, const Nfa& bigger, Run* cex, const Alphabet
  * @param[in] bigger Second automaton to concatenate.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "naive-lazy" (naive on the fly), "antichains", "antichains-sim" (antichains pruned by
+ *   simulation), "congruence" (bisimulation up to congruence) (Default: "antichains")
+ * - "threads" (optional, "antichains" only): number of threads to explore the antichains with ("0" for all hardware
+ *   threads).
+ * - "exploration" (optional, "antichains" only): order of exploration of pairs, "dfs" (default), "bfs", "smallest"
+ *   (smallest macrostates first), or "distance" (states of @p smaller closest to final states first). With "threads",
+ *   each thread explores its own pairs in this order.
  * @return True if @p smaller is included in @p bigger, false otherwise.
  */
 inline bool is_included(const Nfa& smaller, const Nfa& bigger, const Alphabet* const alphabet = nullptr,
@@ -668,6 +961,61 @@ inline bool is_included(const Nfa& smaller, const Nfa& bigger, const Alphabet* c
     return is_included(smaller, bigger, nullptr, alphabet, params);
 }
 
+/**
+ * @brief Checker of inclusion of languages of many NFAs in the language of a single NFA, called bigger.
+ *
+ * Everything that depends only on bigger is computed once and reused by all checks: the distances of states of bigger
+ *  to final states, the forward simulation on bigger (for "antichains-sim"), and the macrostates of bigger (sets of
+ *  states of bigger reachable over the same word) interned together with their successors, i.e., a determinization of
+ *  bigger constructed lazily as the checks need it.
+ *
+ * Interned macrostates are kept per thread, so that checks running in parallel do not need to synchronize.
+ */
+class InclusionChecker {
+public:
+    /**
+     * @param[in] bigger Automaton which language should include the languages of the checked automata.
+     * @param[in] params Parameters of the checks:
+     * - "algorithm":
+     *   - "naive": search of the product of the checked automaton and the determinization of @p bigger,
+     *   - "antichains": antichain algorithm over the macrostates of @p bigger,
+     *   - "antichains-sim": antichain algorithm over the macrostates of @p bigger with states simulated by other
+     *      states of the macrostate removed (using the forward simulation on @p bigger)
+     *   (Default: "antichains").
+     * @throws std::runtime_error Unknown algorithm.
+     */
+    explicit InclusionChecker(Nfa bigger, const ParameterMap& params = {{ "algorithm", "antichains" }});
+    InclusionChecker(InclusionChecker&& other) noexcept;
+    InclusionChecker& operator=(InclusionChecker&& other) noexcept;
+    ~InclusionChecker();
+
+    const Nfa& get_bigger() const;
+
+    /**
+     * @brief Check whether the language of @p smaller is included in the language of bigger.
+     *
+     * @param[in] smaller Automaton to check.
+     * @param[out] cex Counterexample (a word accepted by @p smaller, but not by bigger) if the language is not included.
+     * @return True if the language of @p smaller is included in the language of bigger.
+     */
+    bool check(const Nfa& smaller, Run* cex = nullptr);
+
+    /**
+     * @brief Check inclusion of the languages of all @p smaller automata, using @p num_of_threads threads.
+     *
+     * @param[in] smaller Automata to check.
+     * @param[in] num_of_threads Number of threads to check the automata with.
+     * @param[out] cexs Counterexamples for the automata with languages not included (indexed as @p smaller).
+     * @return Results of check() for the automata of @p smaller.
+     */
+    std::vector<bool> check_all(std::span<const Nfa* const> smaller, size_t num_of_threads = 1,
+                                std::vector<Run>* cexs = nullptr);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+}; // class InclusionChecker.
+
 /**
  * @brief Perform equivalence check of two NFAs: @p lhs and @p rhs.
  *
@@ -675,7 +1023,10 @@ inline bool is_included(const Nfa& smaller, const Nfa& bigger, const Alphabet* c
  * @param[in] rhs Second automaton to concatenate.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params[ Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "naive-lazy" (naive on the fly), "antichains", "antichains-sim" (antichains pruned by
+ *   simulation), "congruence" (bisimulation up to congruence), "hopcroft-karp" (union-find check for
+ *   deterministic automata) (Default: "antichains"). Deterministic automata are checked by "hopcroft-karp" also
+ *   with "antichains".
  * @return True if @p lhs and @p rhs are equivalent, false otherwise.
  */
 bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet* alphabet,
@@ -695,34 +1046,64 @@ bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet* alphabet,
  * @param[in] lhs First automaton to concatenate.
  * @param[in] rhs Second automaton to concatenate.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "naive-lazy" (naive on the fly), "antichains", "antichains-sim" (antichains pruned by
+ *   simulation), "congruence" (bisimulation up to congruence), "hopcroft-karp" (union-find check for
+ *   deterministic automata) (Default: "antichains"). Deterministic automata are checked by "hopcroft-karp" also
+ *   with "antichains".
  * @return True if @p lhs and @p rhs are equivalent, false otherwise.
  */
 bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const ParameterMap& params = {{ "algorithm", "antichains"}});
 
-// Reverting the automaton by one of the three functions below,
-// currently simple_revert seems best (however, not tested enough).
-Nfa revert(const Nfa& aut);
-
-// This revert algorithm is fragile, uses low level accesses to Nfa and static data structures,
-// and it is potentially dangerous when there are used symbols with large numbers (allocates an array indexed by symbols)
-// It is faster asymptotically and for somewhat dense automata,
-// the same or a little bit slower than simple_revert otherwise.
-// Not affected by pre-reserving vectors.
-Nfa fragile_revert(const Nfa& aut);
+/**
+ * @brief Index of the transitions of an automaton by their targets: the reverted transition relation in flat vectors.
+ *
+ * Transitions to the state 'q' are at the positions from 'begins[q]' to 'begins[q + 1] - 1' of 'symbols' and
+ *  'sources', ordered by symbols and then by sources. The transitions are sorted by a counting sort over compacted ids
+ *  of the used symbols and over target states, so the time and memory are linear in the size of the automaton,
+ *  independent of values of the symbols.
+ */
+struct PredecessorIndex {
+    std::vector<size_t> begins{ 0 };
+    std::vector<Symbol> symbols{};
+    std::vector<State> sources{};
 
-// Reverting the automaton by a simple algorithm, which does a lot of random access addition to Post and Move.
-//  Much affected by pre-reserving vectors.
-Nfa simple_revert(const Nfa& aut);
+    PredecessorIndex() = default;
+    /**
+     * @brief Build the index of the transitions of @p aut.
+     * @param[in] num_of_threads Number of threads to sort the transitions with.
+     */
+    explicit PredecessorIndex(const Nfa& aut, size_t num_of_threads = 1);
+};
 
-// Reverting the automaton by a modification of the simple algorithm.
-// It replaces random access addition to SymbolPost by push_back and sorting later, so far seems the slowest of all, except on
-//  dense automata, where it is almost as slow as simple_revert. Candidate for removal.
-Nfa somewhat_simple_revert(const Nfa& aut);
+/**
+ * @brief Revert the automaton: reverse its transitions and swap its initial and final states.
+ *
+ * The reverted delta is built directly from the PredecessorIndex of the automaton.
+ *
+ * @param[in] aut Automaton to revert.
+ * @param[in] num_of_threads Number of threads to sort the transitions and build the state posts with.
+ */
+Nfa revert(const Nfa& aut, size_t num_of_threads = 1);
 
 // Removing epsilon transitions
 Nfa remove_epsilon(const Nfa& aut, Symbol epsilon = EPSILON);
 
+/**
+ * @brief Remove transitions over all epsilon symbols from @p first_epsilon to @p last_epsilon (including) at once.
+ *
+ * All the epsilon symbols are removed by a single computation of epsilon closures. Symbols outside of the range
+ *  (such as the epsilons greater than @p last_epsilon) are kept as ordinary symbols.
+ */
+Nfa remove_epsilon(const Nfa& aut, Symbol first_epsilon, Symbol last_epsilon);
+
+/**
+ * @brief Remove transitions over all symbols in @p epsilons at once.
+ *
+ * All the epsilon symbols are removed by a single computation of epsilon closures. Symbols not in @p epsilons (such
+ *  as the epsilons to be kept) are kept as ordinary symbols.
+ */
+Nfa remove_epsilon(const Nfa& aut, const utils::OrdVector<Symbol>& epsilons);
+
 /** Encodes a vector of strings (each corresponding to one symbol) into a
  *  @c Word instance
  */
@@ -0,0 +1,191 @@
+/* antichain.hh -- Antichain of sets w.r.t. inclusion, indexed for subsumption queries.
+ */
+
+#ifndef MATA_ANTICHAIN_HH_
+#define MATA_ANTICHAIN_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace mata::utils {
+
+/**
+ * @brief Antichain of sets: a collection of sets none of which is a subset of another one.
+ *
+ * Only the minimal sets (w.r.t. inclusion) of all inserted sets are kept: a set which has a stored subset is not
+ *  inserted and inserting a set removes all stored supersets of it. Stored sets are identified by ids assigned at
+ *  insertion, which stay valid (though not alive) after the set is removed, so that worklists of algorithms can hold
+ *  ids and lazily skip the removed ones.
+ *
+ * Sets are stored in buckets by their sizes, so that a subsumption query looks only at the buckets of sets which are
+ *  small (large) enough to be subsets (supersets). Every set has a 64-bit signature with a bit set for each of its
+ *  elements (Bloom-style), and most of the candidates which are not subsets are rejected by comparing the signatures
+ *  in constant time before the sets are compared.
+ *
+ * @tparam Set Ordered set type (such as OrdVector) with size(), iteration, and is_subset_of().
+ */
+template<class Set>
+class Antichain {
+public:
+    using Id = size_t;
+    using Signature = uint64_t;
+
+    /// Id returned when a set is not inserted.
+    static constexpr Id NO_ID{ static_cast<Id>(-1) };
+
+    /// Number of stored sets.
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        entries_.clear();
+        buckets_.clear();
+        size_ = 0;
+    }
+
+    /// Whether the set with @p id is still stored (it has not been removed by inserting its subset).
+    bool is_alive(const Id id) const { return id < entries_.size() && entries_[id].alive; }
+
+    /// Get the stored set with @p id. The set has to be alive.
+    const Set& get(const Id id) const {
+        assert(is_alive(id));
+        return entries_[id].set;
+    }
+
+    /// Check whether a stored set is a subset of @p set, i.e., whether @p set is subsumed by the antichain.
+    bool contains_subset_of(const Set& set) const { return contains_subset_of(set, signature_of(set)); }
+
+    /**
+     * @brief Insert @p set unless it is subsumed, removing all stored supersets of @p set.
+     * @return Id of the inserted set, or NO_ID if a stored set is a subset of @p set.
+     */
+    Id insert(Set set) {
+        const Signature signature{ signature_of(set) };
+        if (contains_subset_of(set, signature)) { return NO_ID; }
+        erase_supersets_of(set, signature);
+        return store(std::move(set), signature);
+    }
+
+    /**
+     * @brief Insert a batch of @p sets at once, keeping only the minimal sets of the antichain and the batch.
+     *
+     * The batch is first minimized on its own (the sets are processed from the smallest ones, so every set is
+     *  compared only with the smaller or equally large sets of the batch), and the stored supersets of the remaining
+     *  sets are then removed in a single pass over the buckets of large enough sets.
+     * @return Ids of the inserted sets in the order of @p sets, NO_ID for sets which are subsumed (by a stored set,
+     *  by a smaller set of the batch, or by an equal set earlier in the batch).
+     */
+    std::vector<Id> insert_batch(std::vector<Set> sets) {
+        std::vector<Id> ids(sets.size(), NO_ID);
+        std::vector<size_t> order(sets.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](const size_t lhs, const size_t rhs) { return sets[lhs].size() < sets[rhs].size(); });
+
+        std::vector<Signature> signatures(sets.size());
+        std::vector<size_t> accepted{};
+        for (const size_t index: order) {
+            signatures[index] = signature_of(sets[index]);
+            if (contains_subset_of(sets[index], signatures[index])) { continue; }
+            const bool subsumed_in_batch = std::any_of(accepted.begin(), accepted.end(), [&](const size_t other) {
+                return is_subsignature(signatures[other], signatures[index]) && sets[other].is_subset_of(sets[index]);
+            });
+            if (!subsumed_in_batch) { accepted.push_back(index); }
+        }
+        if (accepted.empty()) { return ids; }
+
+        const size_t min_size{ sets[accepted.front()].size() };
+        for (size_t bucket{ min_size }; bucket < buckets_.size(); ++bucket) {
+            std::erase_if(buckets_[bucket], [&](const Id id) {
+                Entry& entry{ entries_[id] };
+                const bool has_subset = std::any_of(accepted.begin(), accepted.end(), [&](const size_t index) {
+                    return sets[index].size() <= entry.set.size()
+                           && is_subsignature(signatures[index], entry.signature)
+                           && sets[index].is_subset_of(entry.set);
+                });
+                if (has_subset) { kill(entry); }
+                return has_subset;
+            });
+        }
+
+        for (const size_t index: accepted) { ids[index] = store(std::move(sets[index]), signatures[index]); }
+        return ids;
+    }
+
+    /// Call @p func(id, set) for every stored set.
+    template<class Func>
+    void for_each(Func&& func) const {
+        for (const std::vector<Id>& bucket: buckets_) {
+            for (const Id id: bucket) { func(id, entries_[id].set); }
+        }
+    }
+
+private:
+    struct Entry {
+        Set set;
+        Signature signature;
+        bool alive;
+    };
+
+    std::vector<Entry> entries_{};
+    /// Ids of the stored sets indexed by the sizes of the sets.
+    std::vector<std::vector<Id>> buckets_{};
+    size_t size_{ 0 };
+
+    static Signature signature_of(const Set& set) {
+        Signature signature{ 0 };
+        for (const auto& element: set) {
+            // Fibonacci hashing of the element to one of the 64 bits.
+            signature |= Signature{ 1 } << ((static_cast<uint64_t>(element) * 0x9E3779B97F4A7C15ULL) >> 58);
+        }
+        return signature;
+    }
+
+    /// Whether a set with signature @p lhs can be a subset of a set with signature @p rhs.
+    static bool is_subsignature(const Signature lhs, const Signature rhs) { return (lhs & ~rhs) == 0; }
+
+    bool contains_subset_of(const Set& set, const Signature signature) const {
+        const size_t max_bucket{ std::min(set.size() + 1, buckets_.size()) };
+        for (size_t bucket{ 0 }; bucket < max_bucket; ++bucket) {
+            for (const Id id: buckets_[bucket]) {
+                const Entry& entry{ entries_[id] };
+                if (is_subsignature(entry.signature, signature) && entry.set.is_subset_of(set)) { return true; }
+            }
+        }
+        return false;
+    }
+
+    void erase_supersets_of(const Set& set, const Signature signature) {
+        for (size_t bucket{ set.size() }; bucket < buckets_.size(); ++bucket) {
+            std::erase_if(buckets_[bucket], [&](const Id id) {
+                Entry& entry{ entries_[id] };
+                if (!is_subsignature(signature, entry.signature) || !set.is_subset_of(entry.set)) { return false; }
+                kill(entry);
+                return true;
+            });
+        }
+    }
+
+    void kill(Entry& entry) {
+        entry.alive = false;
+        entry.set = Set{};
+        --size_;
+    }
+
+    Id store(Set set, const Signature signature) {
+        const Id id{ entries_.size() };
+        if (buckets_.size() <= set.size()) { buckets_.resize(set.size() + 1); }
+        buckets_[set.size()].push_back(id);
+        entries_.push_back({ std::move(set), signature, true });
+        ++size_;
+        return id;
+    }
+}; // class Antichain.
+
+} // namespace mata::utils.
+
+#endif // MATA_ANTICHAIN_HH_
@@ -0,0 +1,93 @@
+/* parallel.hh -- helpers for running loops over multiple threads
+ */
+
+#ifndef MATA_UTILS_PARALLEL_HH_
+#define MATA_UTILS_PARALLEL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mata::utils {
+
+/// Maximal number of threads used by the parallel algorithms, larger requested numbers are capped to it.
+constexpr size_t MAX_NUM_OF_THREADS{ 256 };
+
+/**
+ * @brief Parse the number of threads given as a value of the "threads" key of a parameter map.
+ *
+ * @param[in] value Positive number of threads, or "0" to use all hardware threads.
+ * @return Number of threads to use (in [1, MAX_NUM_OF_THREADS]).
+ */
+inline size_t parse_num_of_threads(const std::string& value) {
+    size_t parsed_chars{ 0 };
+    unsigned long num_of_threads{ 0 };
+    // std::stoul() accepts leading whitespace and negative numbers (which wrap around), so require a digit first.
+    if (!value.empty() && value.front() >= '0' && value.front() <= '9') {
+        try {
+            num_of_threads = std::stoul(value, &parsed_chars);
+        } catch (const std::exception&) {
+            parsed_chars = 0;
+        }
+    }
+    if (parsed_chars == 0 || parsed_chars != value.size()) {
+        throw std::runtime_error("invalid number of threads: \"" + value + "\"");
+    }
+    if (num_of_threads == 0) {
+        return std::clamp(size_t{ std::thread::hardware_concurrency() }, size_t{ 1 }, MAX_NUM_OF_THREADS);
+    }
+    return std::min(size_t{ num_of_threads }, MAX_NUM_OF_THREADS);
+}
+
+/**
+ * @brief Call @p func(index, thread) for every index in [0, @p size) using @p num_of_threads threads.
+ *
+ * Indices are handed to the threads in chunks on demand, so the order in which they are processed is not specified.
+ *  @c thread is the number of the thread processing the index (in [0, @p num_of_threads)), which can be used to
+ *  access per-thread scratch space. At most @p size (and MAX_NUM_OF_THREADS) threads are used. The calling thread
+ *  participates in the work. An exception thrown by @p func is rethrown in the calling thread after all threads are
+ *  finished.
+ */
+template<class Func>
+void parallel_for(const size_t size, size_t num_of_threads, Func&& func) {
+    // There is no point in more threads than indices.
+    num_of_threads = std::min({ num_of_threads, size, MAX_NUM_OF_THREADS });
+    if (num_of_threads <= 1) {
+        for (size_t index{ 0 }; index < size; ++index) { func(index, size_t{ 0 }); }
+        return;
+    }
+
+    const size_t chunk{ std::max(size_t{ 1 }, size / (num_of_threads * 8)) };
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> failed{ false };
+    std::vector<std::exception_ptr> exceptions(num_of_threads);
+    auto worker = [&](const size_t thread) {
+        try {
+            for (size_t begin{ next.fetch_add(chunk) }; begin < size && !failed.load(std::memory_order_relaxed);
+                 begin = next.fetch_add(chunk)) {
+                const size_t end{ std::min(size, begin + chunk) };
+                for (size_t index{ begin }; index < end; ++index) { func(index, thread); }
+            }
+        } catch (...) {
+            exceptions[thread] = std::current_exception();
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(num_of_threads - 1);
+    for (size_t thread{ 1 }; thread < num_of_threads; ++thread) { threads.emplace_back(worker, thread); }
+    worker(0);
+    for (std::thread& thread: threads) { thread.join(); }
+    for (const std::exception_ptr& exception: exceptions) {
+        if (exception) { std::rethrow_exception(exception); }
+    }
+}
+
+} // namespace mata::utils.
+
+#endif // MATA_UTILS_PARALLEL_HH_
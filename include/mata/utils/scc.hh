@@ -0,0 +1,211 @@
+/* scc.hh -- Strongly connected components of graphs and their condensations.
+ */
+
+#ifndef MATA_SCC_HH_
+#define MATA_SCC_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mata::utils {
+
+/**
+ * @brief Visitor of tarjan_scc() with no-op hooks.
+ *
+ * Visitors derive from SccVisitor and hide the hooks they are interested in. Hooks are resolved statically, hence,
+ *  the hooks which are not hidden are inlined away.
+ */
+template<class Vertex>
+struct SccVisitor {
+    /// Called when @p vertex is discovered. Returning true stops the traversal.
+    bool discover_vertex(const Vertex vertex) { (void)vertex; return false; }
+    /// Called for every edge from @p source to @p target followed (or skipped as already discovered).
+    void examine_edge(const Vertex source, const Vertex target) { (void)source; (void)target; }
+    /// Called with the vertices of a completed SCC. Returning true stops the traversal.
+    bool finish_scc(const std::span<const Vertex> scc) { (void)scc; return false; }
+};
+
+/**
+ * @brief Compute the SCCs of the vertices reachable from @p roots with an iterative version of Tarjan's algorithm.
+ *
+ * SCCs are completed (see SccVisitor::finish_scc()) in a reverse topological order: every SCC reachable from an SCC
+ *  is completed before it.
+ * @param[in] num_of_vertices Number of vertices, which are numbered 0, ..., @p num_of_vertices - 1.
+ * @param[in] roots Vertices to start the search from.
+ * @param[in] successors Function returning a range of (the projections of) the successors of a vertex. Its iterators
+ *  have to stay valid when the range itself is destroyed, which holds for views and references to containers.
+ * @param[in,out] visitor Visitor with the hooks of SccVisitor.
+ * @param[in] projection Projection of the elements of the ranges returned by @p successors to vertices.
+ * @return True iff the traversal was stopped by the visitor.
+ */
+template<class Roots, class Successors, class Visitor, class Projection = std::identity>
+bool tarjan_scc(const size_t num_of_vertices, const Roots& roots, const Successors& successors, Visitor& visitor,
+                const Projection& projection = {}) {
+    using Vertex = std::remove_cvref_t<decltype(*std::begin(roots))>;
+    using Iterator = decltype(std::begin(successors(Vertex{})));
+    constexpr size_t UNDEFINED{ std::numeric_limits<size_t>::max() };
+
+    // Simulated call stack: a vertex and the positions of its successors to visit.
+    struct Frame {
+        Vertex vertex;
+        Iterator current;
+        Iterator end;
+    };
+
+    std::vector<size_t> index(num_of_vertices, UNDEFINED);
+    std::vector<size_t> lowlink(num_of_vertices);
+    std::vector<bool> on_stack(num_of_vertices, false);
+    std::vector<Vertex> tarjan_stack{};
+    std::vector<Frame> call_stack{};
+    size_t next_index{ 0 };
+
+    auto discover = [&](const Vertex vertex) {
+        index[vertex] = lowlink[vertex] = next_index++;
+        tarjan_stack.push_back(vertex);
+        on_stack[vertex] = true;
+        auto&& range{ successors(vertex) };
+        call_stack.push_back({ vertex, std::begin(range), std::end(range) });
+        return visitor.discover_vertex(vertex);
+    };
+
+    for (const Vertex root: roots) {
+        if (index[root] != UNDEFINED) { continue; }
+        if (discover(root)) { return true; }
+        while (!call_stack.empty()) {
+            Frame& frame{ call_stack.back() };
+            const Vertex vertex{ frame.vertex };
+            if (frame.current != frame.end) {
+                const Vertex target{ static_cast<Vertex>(std::invoke(projection, *frame.current)) };
+                ++frame.current;
+                visitor.examine_edge(vertex, target);
+                if (index[target] == UNDEFINED) {
+                    if (discover(target)) { return true; }
+                } else if (on_stack[target]) {
+                    lowlink[vertex] = std::min(lowlink[vertex], index[target]);
+                }
+                continue;
+            }
+
+            call_stack.pop_back();
+            if (!call_stack.empty()) {
+                const Vertex parent{ call_stack.back().vertex };
+                lowlink[parent] = std::min(lowlink[parent], lowlink[vertex]);
+            }
+            if (lowlink[vertex] == index[vertex]) {
+                // The SCC is the top of the Tarjan stack down to (and including) 'vertex'.
+                auto scc_begin{ tarjan_stack.end() };
+                do { --scc_begin; on_stack[*scc_begin] = false; } while (*scc_begin != vertex);
+                const bool stop{ visitor.finish_scc(std::span<const Vertex>{ scc_begin, tarjan_stack.end() }) };
+                tarjan_stack.erase(scc_begin, tarjan_stack.end());
+                if (stop) { return true; }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Condensation of a graph: the DAG of its SCCs.
+ *
+ * SCCs are numbered in a topological order: every edge between two different SCCs leads from a smaller SCC to a greater
+ *  one. Hence, processing SCCs from the greatest one processes all successors of an SCC before the SCC itself.
+ */
+template<class Vertex>
+struct Condensation {
+    /// SCC of a vertex which has not been reached from the roots.
+    static constexpr size_t NO_SCC{ std::numeric_limits<size_t>::max() };
+
+    /// SCC of each vertex.
+    std::vector<size_t> scc_of{};
+    /// Vertices of the SCC 'c' are 'vertices[begins[c]]', ..., 'vertices[begins[c + 1] - 1]'.
+    std::vector<Vertex> vertices{};
+    std::vector<size_t> begins{ 0 };
+    /// Distinct successor SCCs of the SCC 'c' are 'dag_targets[dag_begins[c]]', ..., 'dag_targets[dag_begins[c + 1] - 1]'.
+    std::vector<size_t> dag_targets{};
+    std::vector<size_t> dag_begins{ 0 };
+    /// Whether the SCC contains a cycle, i.e., it has more than one vertex or a self-loop.
+    std::vector<bool> cyclic{};
+
+    size_t num_of_sccs() const { return begins.size() - 1; }
+
+    std::span<const Vertex> scc(const size_t scc) const {
+        return { vertices.begin() + static_cast<long>(begins[scc]), vertices.begin() + static_cast<long>(begins[scc + 1]) };
+    }
+
+    std::span<const size_t> scc_successors(const size_t scc) const {
+        return { dag_targets.begin() + static_cast<long>(dag_begins[scc]),
+                 dag_targets.begin() + static_cast<long>(dag_begins[scc + 1]) };
+    }
+}; // struct Condensation.
+
+/**
+ * @brief Compute the condensation of the part of a graph reachable from @p roots.
+ *
+ * See tarjan_scc() for the parameters.
+ */
+template<class Roots, class Successors, class Projection = std::identity>
+auto compute_condensation(const size_t num_of_vertices, const Roots& roots, const Successors& successors,
+                          const Projection& projection = {}) {
+    using Vertex = std::remove_cvref_t<decltype(*std::begin(roots))>;
+    using Result = Condensation<Vertex>;
+
+    // Collect SCCs in the order of their completion, i.e., in the reverse topological order.
+    struct Collector : SccVisitor<Vertex> {
+        std::vector<Vertex> vertices{};
+        std::vector<size_t> ends{};
+
+        bool finish_scc(const std::span<const Vertex> scc) {
+            vertices.insert(vertices.end(), scc.begin(), scc.end());
+            ends.push_back(vertices.size());
+            return false;
+        }
+    } collector{};
+    tarjan_scc(num_of_vertices, roots, successors, collector, projection);
+
+    Result result{};
+    const size_t num_of_sccs{ collector.ends.size() };
+    result.scc_of.assign(num_of_vertices, Result::NO_SCC);
+    result.vertices.reserve(collector.vertices.size());
+    result.begins.reserve(num_of_sccs + 1);
+    for (size_t scc{ 0 }; scc < num_of_sccs; ++scc) {
+        const size_t completed{ num_of_sccs - 1 - scc };
+        const size_t begin{ completed == 0 ? 0 : collector.ends[completed - 1] };
+        for (size_t i{ begin }; i < collector.ends[completed]; ++i) {
+            result.scc_of[collector.vertices[i]] = scc;
+            result.vertices.push_back(collector.vertices[i]);
+        }
+        result.begins.push_back(result.vertices.size());
+    }
+
+    result.cyclic.assign(num_of_sccs, false);
+    result.dag_begins.reserve(num_of_sccs + 1);
+    // 'last_source[d] == c' iff the SCC 'd' has already been added as a successor of 'c'.
+    std::vector<size_t> last_source(num_of_sccs, Result::NO_SCC);
+    for (size_t scc{ 0 }; scc < num_of_sccs; ++scc) {
+        result.cyclic[scc] = result.begins[scc + 1] - result.begins[scc] > 1;
+        for (const Vertex vertex: result.scc(scc)) {
+            for (auto&& element: successors(vertex)) {
+                const size_t target_scc{ result.scc_of[static_cast<Vertex>(std::invoke(projection, element))] };
+                if (target_scc == scc) {
+                    result.cyclic[scc] = true;
+                } else if (last_source[target_scc] != scc) {
+                    last_source[target_scc] = scc;
+                    result.dag_targets.push_back(target_scc);
+                }
+            }
+        }
+        result.dag_begins.push_back(result.dag_targets.size());
+    }
+    return result;
+}
+
+} // namespace mata::utils.
+
+#endif // MATA_SCC_HH_
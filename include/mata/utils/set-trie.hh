@@ -0,0 +1,180 @@
+/* set-trie.hh -- Index of sets supporting subset and superset queries.
+ */
+
+#ifndef MATA_SET_TRIE_HH_
+#define MATA_SET_TRIE_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "ord-vector.hh"
+
+namespace mata::utils {
+
+/**
+ * @brief Set-trie: an index of ordered sets with values, answering subset and superset queries.
+ *
+ * Every stored set is a path from the root labelled by the elements of the set in increasing order. A subset query
+ *  descends only along the elements of the queried set, a superset query may skip elements smaller than the next
+ *  element of the queried set but never jumps over it. Both therefore visit only a small part of the trie compared
+ *  to testing every stored set with OrdVector::is_subset_of().
+ *
+ * Erased sets only clear the value of their node, the nodes themselves are kept.
+ *
+ * @tparam Element Type of the elements of the sets.
+ * @tparam Value Type of the values stored with the sets.
+ */
+template<class Element, class Value>
+class SetTrie {
+public:
+    using Set = OrdVector<Element>;
+
+    SetTrie() : nodes_(1) {}
+
+    /// Number of stored sets.
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        nodes_.clear();
+        nodes_.emplace_back();
+        size_ = 0;
+    }
+
+    /**
+     * @brief Store @p set with @p value.
+     * @return False if @p set was already stored (its value is then overwritten), true otherwise.
+     */
+    bool insert(const Set& set, const Value& value) {
+        size_t node{ 0 };
+        for (const Element& element: set) {
+            auto& children{ nodes_[node].children };
+            auto child_it{ std::lower_bound(children.begin(), children.end(), element,
+                                            [](const auto& child, const Element& elem) { return child.first < elem; }) };
+            if (child_it != children.end() && child_it->first == element) {
+                node = child_it->second;
+            } else {
+                const size_t new_node{ nodes_.size() };
+                children.emplace(child_it, element, new_node);
+                nodes_.emplace_back();
+                node = new_node;
+            }
+        }
+        const bool inserted{ !nodes_[node].has_value };
+        nodes_[node].has_value = true;
+        nodes_[node].value = value;
+        if (inserted) { ++size_; }
+        return inserted;
+    }
+
+    /**
+     * @brief Remove @p set from the index.
+     * @return True if @p set was stored.
+     */
+    bool erase(const Set& set) {
+        const size_t node{ find_node(set) };
+        if (node == NO_NODE || !nodes_[node].has_value) { return false; }
+        nodes_[node].has_value = false;
+        --size_;
+        return true;
+    }
+
+    /// Get the value stored with @p set, or nullptr if @p set is not stored.
+    const Value* find(const Set& set) const {
+        const size_t node{ find_node(set) };
+        if (node == NO_NODE || !nodes_[node].has_value) { return nullptr; }
+        return &nodes_[node].value;
+    }
+
+    bool contains(const Set& set) const { return find(set) != nullptr; }
+
+    /**
+     * @brief Call @p func with the value of every stored subset of @p set (including @p set itself).
+     *
+     * The index must not be modified by @p func.
+     */
+    template<class Func>
+    void for_each_subset_of(const Set& set, Func&& func) const {
+        subsets(0, set.begin(), set.end(), func);
+    }
+
+    /**
+     * @brief Call @p func with the value of every stored superset of @p set (including @p set itself).
+     *
+     * The index must not be modified by @p func.
+     */
+    template<class Func>
+    void for_each_superset_of(const Set& set, Func&& func) const {
+        supersets(0, set.begin(), set.end(), func);
+    }
+
+    /// Check whether some stored set is a subset of @p set.
+    bool contains_subset_of(const Set& set) const { return any_subset(0, set.begin(), set.end()); }
+
+private:
+    using SetIterator = typename Set::const_iterator;
+
+    static constexpr size_t NO_NODE{ static_cast<size_t>(-1) };
+
+    struct Node {
+        /// Children sorted by the element on the edge.
+        std::vector<std::pair<Element, size_t>> children{};
+        bool has_value{ false };
+        Value value{};
+    };
+
+    std::vector<Node> nodes_;
+    size_t size_{ 0 };
+
+    size_t find_node(const Set& set) const {
+        size_t node{ 0 };
+        for (const Element& element: set) {
+            const auto& children{ nodes_[node].children };
+            auto child_it{ std::lower_bound(children.begin(), children.end(), element,
+                                            [](const auto& child, const Element& elem) { return child.first < elem; }) };
+            if (child_it == children.end() || child_it->first != element) { return NO_NODE; }
+            node = child_it->second;
+        }
+        return node;
+    }
+
+    template<class Func>
+    void subsets(const size_t node, SetIterator set_it, const SetIterator set_end, Func& func) const {
+        if (nodes_[node].has_value) { func(nodes_[node].value); }
+        for (const auto& [element, child]: nodes_[node].children) {
+            set_it = std::lower_bound(set_it, set_end, element);
+            if (set_it == set_end) { return; }
+            if (*set_it == element) { subsets(child, set_it + 1, set_end, func); }
+        }
+    }
+
+    template<class Func>
+    void supersets(const size_t node, const SetIterator set_it, const SetIterator set_end, Func& func) const {
+        if (set_it == set_end && nodes_[node].has_value) { func(nodes_[node].value); }
+        for (const auto& [element, child]: nodes_[node].children) {
+            if (set_it == set_end || element < *set_it) {
+                supersets(child, set_it, set_end, func);
+            } else if (element == *set_it) {
+                supersets(child, set_it + 1, set_end, func);
+            } else {
+                return;
+            }
+        }
+    }
+
+    bool any_subset(const size_t node, SetIterator set_it, const SetIterator set_end) const {
+        if (nodes_[node].has_value) { return true; }
+        for (const auto& [element, child]: nodes_[node].children) {
+            set_it = std::lower_bound(set_it, set_end, element);
+            if (set_it == set_end) { return false; }
+            if (*set_it == element && any_subset(child, set_it + 1, set_end)) { return true; }
+        }
+        return false;
+    }
+}; // class SetTrie.
+
+} // namespace mata::utils.
+
+#endif // MATA_SET_TRIE_HH_
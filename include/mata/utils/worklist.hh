@@ -0,0 +1,103 @@
+/* worklist.hh -- Worklist with a configurable order of processing of its items.
+ */
+
+#ifndef MATA_WORKLIST_HH_
+#define MATA_WORKLIST_HH_
+
+#include <cassert>
+#include <deque>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mata::utils {
+
+/// Order in which a Worklist pops its items.
+enum class WorklistOrder {
+    DFS, ///< The last pushed item first (a stack).
+    BFS, ///< The first pushed item first (a queue).
+    PRIORITY, ///< The item with the smallest priority first, items with equal priorities in the DFS order.
+};
+
+/**
+ * @brief Worklist of items to be processed, popping the items in the given WorklistOrder.
+ *
+ * Priorities passed to push() are ignored by the DFS and BFS orders.
+ *
+ * @tparam Item Type of the items.
+ */
+template<class Item>
+class Worklist {
+public:
+    using Order = WorklistOrder;
+
+    explicit Worklist(const Order order = Order::DFS) : order_{ order } {}
+
+    bool empty() const { return order_ == Order::PRIORITY ? heap_.empty() : items_.empty(); }
+    size_t size() const { return order_ == Order::PRIORITY ? heap_.size() : items_.size(); }
+
+    void push(Item item, const size_t priority = 0) {
+        if (order_ == Order::PRIORITY) {
+            heap_.push({ priority, next_sequence_number_++, std::move(item) });
+        } else {
+            items_.push_back(std::move(item));
+        }
+    }
+
+    /// Remove the next item to be processed and return it. The worklist must not be empty.
+    Item pop() {
+        assert(!empty());
+        Item item{};
+        switch (order_) {
+            case Order::DFS:
+                item = std::move(items_.back());
+                items_.pop_back();
+                break;
+            case Order::BFS:
+                item = std::move(items_.front());
+                items_.pop_front();
+                break;
+            case Order::PRIORITY:
+                item = heap_.top().item;
+                heap_.pop();
+                break;
+        }
+        return item;
+    }
+
+    /**
+     * @brief Remove an item to be processed by another worker and return it. The worklist must not be empty.
+     *
+     * In the DFS order, the earliest pushed item is removed, which tends to have the most work below it. In the other
+     *  orders, the next item is removed as by pop().
+     */
+    Item steal() {
+        assert(!empty());
+        if (order_ != Order::DFS) { return pop(); }
+        Item item{ std::move(items_.front()) };
+        items_.pop_front();
+        return item;
+    }
+
+private:
+    struct PrioritizedItem {
+        size_t priority;
+        size_t sequence_number;
+        Item item{};
+
+        /// Ordering of the max-heap: the smallest priority, and the latest pushed among equal priorities, is on top.
+        bool operator<(const PrioritizedItem& other) const {
+            return std::tie(other.priority, sequence_number) < std::tie(priority, other.sequence_number);
+        }
+    };
+
+    Order order_;
+    std::deque<Item> items_{};
+    std::priority_queue<PrioritizedItem> heap_{};
+    size_t next_sequence_number_{ 0 };
+}; // class Worklist.
+
+} // namespace mata::utils.
+
+#endif // MATA_WORKLIST_HH_
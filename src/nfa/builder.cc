@@ -252,3 +252,183 @@ Nfa builder::parse_from_mata(const std::string& nfa_in_mata) {
     std::istringstream nfa_stream(nfa_in_mata);
     return parse_from_mata(nfa_stream);
 }
+
+size_t builder::MinimalAcyclicDfaBuilder::RegisterHash::operator()(const State state) const {
+    const DfaState& dfa_state{ (*states)[state] };
+    size_t hash{ dfa_state.is_final ? 1U : 0U };
+    for (const auto& [symbol, target]: dfa_state.transitions) {
+        hash = mata::utils::hash_combine(hash, symbol);
+        hash = mata::utils::hash_combine(hash, target);
+    }
+    return hash;
+}
+
+bool builder::MinimalAcyclicDfaBuilder::RegisterEqual::operator()(const State lhs, const State rhs) const {
+    const DfaState& lhs_state{ (*states)[lhs] };
+    const DfaState& rhs_state{ (*states)[rhs] };
+    return lhs_state.is_final == rhs_state.is_final && lhs_state.transitions == rhs_state.transitions;
+}
+
+builder::MinimalAcyclicDfaBuilder::MinimalAcyclicDfaBuilder(const bool sorted_words)
+    : sorted_words_{ sorted_words }, register_{ 0, RegisterHash{ &states_ }, RegisterEqual{ &states_ } } {
+    path_.push_back(new_state());
+}
+
+State builder::MinimalAcyclicDfaBuilder::new_state() {
+    if (!free_states_.empty()) {
+        const State state{ free_states_.back() };
+        free_states_.pop_back();
+        return state;
+    }
+    states_.emplace_back();
+    return states_.size() - 1;
+}
+
+void builder::MinimalAcyclicDfaBuilder::delete_state(const State state) {
+    DfaState& dfa_state{ states_[state] };
+    for (const auto& transition: dfa_state.transitions) { --states_[transition.second].in_degree; }
+    dfa_state.transitions.clear();
+    dfa_state.is_final = false;
+    dfa_state.in_degree = 0;
+    free_states_.push_back(state);
+}
+
+State* builder::MinimalAcyclicDfaBuilder::find_transition(const State state, const Symbol symbol) {
+    auto& transitions{ states_[state].transitions };
+    auto it{ std::lower_bound(transitions.begin(), transitions.end(), symbol,
+                              [](const auto& transition, const Symbol symb) { return transition.first < symb; }) };
+    if (it == transitions.end() || it->first != symbol) { return nullptr; }
+    return &it->second;
+}
+
+void builder::MinimalAcyclicDfaBuilder::add_transition(const State source, const Symbol symbol, const State target) {
+    auto& transitions{ states_[source].transitions };
+    auto it{ std::lower_bound(transitions.begin(), transitions.end(), symbol,
+                              [](const auto& transition, const Symbol symb) { return transition.first < symb; }) };
+    transitions.emplace(it, symbol, target);
+    ++states_[target].in_degree;
+}
+
+void builder::MinimalAcyclicDfaBuilder::replace_or_register(const State parent, const Symbol symbol, const State state) {
+    const auto registered{ register_.find(state) };
+    if (registered == register_.end()) {
+        register_.insert(state);
+        return;
+    }
+    const State equivalent{ *registered };
+    *find_transition(parent, symbol) = equivalent;
+    ++states_[equivalent].in_degree;
+    delete_state(state);
+}
+
+void builder::MinimalAcyclicDfaBuilder::add_word(const Word& word) {
+    if (sorted_words_) { add_sorted_word(word); }
+    else { add_unsorted_word(word); }
+}
+
+void builder::MinimalAcyclicDfaBuilder::add_sorted_word(const Word& word) {
+    if (word < previous_word_) {
+        throw std::runtime_error(std::string(__func__) + ": words are not sorted");
+    }
+    if (!previous_word_.empty() && word == previous_word_) { return; }
+
+    const size_t common_prefix_length{ static_cast<size_t>(
+        std::mismatch(word.begin(), word.end(), previous_word_.begin(), previous_word_.end()).first - word.begin()) };
+
+    // The states along the previous word after the common prefix are finished.
+    for (size_t length{ previous_word_.size() }; length > common_prefix_length; --length) {
+        replace_or_register(path_[length - 1], previous_word_[length - 1], path_[length]);
+    }
+    path_.resize(common_prefix_length + 1);
+
+    for (size_t position{ common_prefix_length }; position < word.size(); ++position) {
+        const State state{ new_state() };
+        add_transition(path_.back(), word[position], state);
+        path_.push_back(state);
+    }
+    states_[path_.back()].is_final = true;
+    previous_word_ = word;
+}
+
+void builder::MinimalAcyclicDfaBuilder::add_unsorted_word(const Word& word) {
+    // The longest prefix of the word readable in the automaton.
+    std::vector<State> path{ path_[0] };
+    for (const Symbol symbol: word) {
+        const State* target{ find_transition(path.back(), symbol) };
+        if (target == nullptr) { break; }
+        path.push_back(*target);
+    }
+    if (path.size() == word.size() + 1 && states_[path.back()].is_final) { return; }
+
+    // Make the states along the prefix private to the new word: confluence states (with more incoming transitions)
+    //  are cloned, the other states are taken out of the register as they are going to change.
+    for (size_t length{ 1 }; length < path.size(); ++length) {
+        const State state{ path[length] };
+        if (states_[state].in_degree > 1) {
+            const State clone{ new_state() };
+            states_[clone].is_final = states_[state].is_final;
+            states_[clone].transitions = states_[state].transitions;
+            for (const auto& transition: states_[clone].transitions) { ++states_[transition.second].in_degree; }
+            *find_transition(path[length - 1], word[length - 1]) = clone;
+            --states_[state].in_degree;
+            ++states_[clone].in_degree;
+            path[length] = clone;
+        } else {
+            register_.erase(state);
+        }
+    }
+
+    for (size_t position{ path.size() - 1 }; position < word.size(); ++position) {
+        const State state{ new_state() };
+        add_transition(path.back(), word[position], state);
+        path.push_back(state);
+    }
+    states_[path.back()].is_final = true;
+
+    for (size_t length{ word.size() }; length > 0; --length) {
+        replace_or_register(path[length - 1], word[length - 1], path[length]);
+    }
+}
+
+Nfa builder::MinimalAcyclicDfaBuilder::build() {
+    if (sorted_words_) {
+        for (size_t length{ previous_word_.size() }; length > 0; --length) {
+            replace_or_register(path_[length - 1], previous_word_[length - 1], path_[length]);
+        }
+    }
+
+    const State root{ path_[0] };
+    const size_t num_of_states{ this->num_of_states() };
+    Nfa result{ num_of_states, StateSet{ 0 }, StateSet{} };
+    std::vector<State> renaming(states_.size(), Limits::max_state);
+    std::vector<State> order{ root };
+    order.reserve(num_of_states);
+    renaming[root] = 0;
+    for (size_t index{ 0 }; index < order.size(); ++index) {
+        const State state{ order[index] };
+        if (states_[state].is_final) { result.final.insert(renaming[state]); }
+        StatePost& state_post{ result.delta.mutable_state_post(renaming[state]) };
+        for (const auto& [symbol, target]: states_[state].transitions) {
+            if (renaming[target] == Limits::max_state) {
+                renaming[target] = order.size();
+                order.push_back(target);
+            }
+            state_post.push_back(SymbolPost{ symbol, StateSet{ renaming[target] } });
+        }
+    }
+    result.delta.release_mutable_references();
+
+    states_.clear();
+    free_states_.clear();
+    register_.clear();
+    previous_word_.clear();
+    path_.clear();
+    path_.push_back(new_state());
+    return result;
+}
+
+Nfa builder::create_minimal_acyclic_dfa(const std::vector<Word>& words, const bool sorted_words) {
+    MinimalAcyclicDfaBuilder dfa_builder{ sorted_words };
+    for (const Word& word: words) { dfa_builder.add_word(word); }
+    return dfa_builder.build();
+}
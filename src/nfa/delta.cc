@@ -76,6 +76,7 @@ std::vector<Transition> Delta::get_transitions_to(const State state_to) const {
 }
 
 void Delta::add(State source, Symbol symbol, State target) {
+    touch();
     const State max_state{ std::max(source, target) };
     if (max_state >= state_posts_.size()) {
         reserve_on_insert(state_posts_, max_state);
@@ -105,6 +106,7 @@ void Delta::add(const State source, const Symbol symbol, const StateSet& targets
     if(targets.empty()) {
         return;
     }
+    touch();
 
     const State max_state{ std::max(source, targets.back()) };
     if (max_state >= state_posts_.size()) {
@@ -136,6 +138,7 @@ void Delta::remove(State src, Symbol symb, State tgt) {
     if (src >= state_posts_.size()) {
         return;
     }
+    touch();
 
     StatePost& state_transitions{ state_posts_[src] };
     if (state_transitions.empty()) {
@@ -315,6 +318,7 @@ std::vector<StatePost> Delta::renumber_targets(const std::function<State(State)>
 }
 
 StatePost& Delta::mutable_state_post(State q) {
+    track_mutable_references();
     if (q >= state_posts_.size()) {
         utils::reserve_on_insert(state_posts_, q);
         const size_t new_size{ q + 1 };
@@ -325,6 +329,7 @@ StatePost& Delta::mutable_state_post(State q) {
 }
 
 void Delta::defragment(const BoolVector& is_staying, const std::vector<State>& renaming) {
+    touch();
     //TODO: this function seems to be unreadable, should be refactored, maybe into several functions with a clear functionality?
 
     //first, indexes of post are filtered (places of to be removed states are taken by states on their right)
@@ -340,7 +345,7 @@ void Delta::defragment(const BoolVector& is_staying, const std::vector<State>& r
     //this iterates through every post and every move, filters and renames states,
     //and then removes moves that became empty.
     for (State q=0,size=state_posts_.size(); q < size; ++q) {
-        StatePost & p = mutable_state_post(q);
+        StatePost & p = state_posts_[q];
         for (auto move = p.begin(); move < p.end(); ++move) {
             move->targets.erase(
                     std::remove_if(move->targets.begin(), move->targets.end(), [&](State q) -> bool {
@@ -359,6 +364,18 @@ void Delta::defragment(const BoolVector& is_staying, const std::vector<State>& r
     }
 }
 
+bool Delta::equals_tracked_content() const {
+    // SymbolPost::operator==() compares symbols only, hence the targets are compared explicitly.
+    return std::equal(state_posts_.begin(), state_posts_.end(), tracked_content_->begin(), tracked_content_->end(),
+                      [](const StatePost& lhs, const StatePost& rhs) {
+                          return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                            [](const SymbolPost& lhs_post, const SymbolPost& rhs_post) {
+                                                return lhs_post.symbol == rhs_post.symbol
+                                                       && lhs_post.targets == rhs_post.targets;
+                                            });
+                      });
+}
+
 bool Delta::operator==(const Delta& other) const {
     Delta::Transitions this_transitions{ transitions() };
     Delta::Transitions::const_iterator this_transitions_it{ this_transitions.begin() };
@@ -524,8 +541,7 @@ void Delta::add_symbols_to(OnTheFlyAlphabet& target_alphabet) const {
 
 OrdVector<Symbol> Delta::get_used_symbols() const {
     //TODO: look at the variants in profiling (there are tests in tests-nfa-profiling.cc),
-    // for instance figure out why NumberPredicate and OrdVector are slow,
-    // try also with _STATIC_DATA_STRUCTURES_, it changes things.
+    // for instance figure out why NumberPredicate and OrdVector are slow.
 
     //below are different variant, with different data structures for accumulating symbols,
     //that then must be converted to an OrdVector
@@ -575,12 +591,7 @@ OrdVector<Symbol> Delta::get_used_symbols() const {
 // Other versions, maybe an interesting experiment with speed of data structures.
 // Returns symbols appearing in Delta, pushes back to vector and then sorts
 mata::utils::OrdVector<Symbol> Delta::get_used_symbols_vec() const {
-#ifdef _STATIC_STRUCTURES_
-    static std::vector<Symbol> symbols{};
-    symbols.clear();
-#else
     std::vector<Symbol> symbols{};
-#endif
     for (const StatePost& state_post: state_posts_) {
         for (const SymbolPost & symbol_post: state_post) {
             utils::reserve_on_insert(symbols);
@@ -593,13 +604,7 @@ mata::utils::OrdVector<Symbol> Delta::get_used_symbols_vec() const {
 
 // returns symbols appearing in Delta, inserts to a std::set
 std::set<Symbol> Delta::get_used_symbols_set() const {
-    //static should prevent reallocation, seems to speed things up a little
-#ifdef _STATIC_STRUCTURES_
-    static std::set<Symbol>  symbols;
-    symbols.clear();
-#else
-    static std::set<Symbol>  symbols{};
-#endif
+    std::set<Symbol> symbols{};
     for (const StatePost& state_post: state_posts_) {
         for (const SymbolPost& symbol_post: state_post) {
             symbols.insert(symbol_post.symbol);
@@ -613,13 +618,7 @@ std::set<Symbol> Delta::get_used_symbols_set() const {
 // returns symbols appearing in Delta, adds to NumberPredicate,
 // Seems to be the fastest option, but could have problems with large maximum symbols
 mata::utils::SparseSet<Symbol> Delta::get_used_symbols_sps() const {
-#ifdef _STATIC_STRUCTURES_
-    //static seems to speed things up a little
-    static utils::SparseSet<Symbol> symbols(64,false);
-    symbols.clear();
-#else
     utils::SparseSet<Symbol> symbols(64);
-#endif
     //symbols.dont_track_elements();
     for (const StatePost& state_post: state_posts_) {
         for (const SymbolPost & symbol_post: state_post) {
@@ -633,13 +632,7 @@ mata::utils::SparseSet<Symbol> Delta::get_used_symbols_sps() const {
 // returns symbols appearing in Delta, adds to NumberPredicate,
 // Seems to be the fastest option, but could have problems with large maximum symbols
 std::vector<bool> Delta::get_used_symbols_bv() const {
-#ifdef _STATIC_STRUCTURES_
-    //static seems to speed things up a little
-    static std::vector<bool> symbols(64, false);
-    symbols.clear();
-#else
     std::vector<bool> symbols(64, false);
-#endif
     //symbols.dont_track_elements();
     for (const StatePost& state_post: state_posts_) {
         for (const SymbolPost& symbol_post: state_post) {
@@ -655,13 +648,7 @@ std::vector<bool> Delta::get_used_symbols_bv() const {
 }
 
 mata::BoolVector Delta::get_used_symbols_chv() const {
-#ifdef _STATIC_STRUCTURES_
-    //static seems to speed things up a little
-    static BoolVector symbols(64,false);
-    symbols.clear();
-#else
     BoolVector symbols(64,false);
-#endif
     //symbols.dont_track_elements();
     for (const StatePost& state_post: state_posts_) {
         for (const SymbolPost& symbol_post: state_post) {
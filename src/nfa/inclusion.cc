@@ -5,9 +5,22 @@
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/antichain.hh"
+#include "mata/utils/parallel.hh"
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace mata::nfa;
 using namespace mata::utils;
+using mata::Symbol;
+using mata::Word;
 
 /// naive language inclusion check (complementation + intersection + emptiness)
 bool mata::nfa::algorithms::is_included_naive(
@@ -27,8 +40,210 @@ bool mata::nfa::algorithms::is_included_naive(
 } // is_included_naive }}}
 
 
+namespace {
+    /**
+     * Disjoint union of @p lhs and @p rhs, where states of @p rhs are shifted by the number of states of @p lhs.
+     *  Unlike Nfa::unite_nondet_with(), all states and transitions are kept even if some of the automata have no
+     *  initial or final states.
+     */
+    Nfa disjoint_union(const Nfa& lhs, const Nfa& rhs) {
+        const size_t offset{ lhs.num_of_states() };
+        auto shift = [&](const State state) { return state + offset; };
+        Nfa united{ lhs };
+        united.delta.allocate(offset);
+        united.delta.append(rhs.delta.renumber_targets(shift));
+        for (const State state: rhs.initial) { united.initial.insert(shift(state)); }
+        for (const State state: rhs.final) { united.final.insert(shift(state)); }
+        return united;
+    }
+
+    /**
+     * Parents of the product states discovered by an inclusion check, for the reconstruction of counterexamples.
+     *
+     * Product states get consecutive ids and the parent and the symbol of each product state are stored in flat
+     *  vectors indexed by the ids, so neither the product states nor their macrostates are copied.
+     */
+    class ProductStateParents {
+    public:
+        /// Add an initial product state, return its id.
+        size_t add_initial() { return add(parents_.size(), 0); }
+
+        /// Add a product state accessed from the product state @p parent over @p symbol, return its id.
+        size_t add(const size_t parent, const Symbol symbol) {
+            parents_.push_back(parent);
+            symbols_.push_back(symbol);
+            return parents_.size() - 1;
+        }
+
+        /// Get the word leading to the product state @p id followed by @p last_symbol.
+        Word get_word(size_t id, const Symbol last_symbol) const {
+            Word word{ last_symbol };
+            for (; parents_[id] != id; id = parents_[id]) { word.push_back(symbols_[id]); }
+            std::reverse(word.begin(), word.end());
+            return word;
+        }
+
+    private:
+        std::vector<size_t> parents_{};
+        std::vector<Symbol> symbols_{};
+    };
+
+    /**
+     * Append to @p word a shortest word leading from @p state to a final state of @p aut.
+     *
+     * Used when a violation of inclusion is detected by comparing distances to final states: the word leading to the
+     *  product state must be extended to be accepted by the smaller automaton.
+     */
+    void append_shortest_word_to_final(const Nfa& aut, State state, Word& word) {
+        const std::vector<State>& distances{ aut.distances_to_final() };
+        while (distances[state] != 0) {
+            bool found{ false };
+            for (const SymbolPost& symbol_post: aut.delta[state]) {
+                for (const State target: symbol_post.targets) {
+                    if (distances[target] + 1 == distances[state]) {
+                        word.push_back(symbol_post.symbol);
+                        state = target;
+                        found = true;
+                        break;
+                    }
+                }
+                if (found) { break; }
+            }
+            assert(found);
+        }
+    }
+
+    /**
+     * Determinization of an automaton constructed lazily. Macrostates get consecutive ids when they are reached, and
+     *  successors of a macrostate are computed (over all symbols at once) when they are first asked for. The empty
+     *  macrostate stands for the sink state of the completion of the automaton.
+     */
+    class LazyDeterminization {
+    public:
+        /// Function reducing a reached macrostate to the macrostate to store, e.g., by removing simulated states.
+        using Reduction = std::function<StateSet(const StateSet&)>;
+
+        explicit LazyDeterminization(const Nfa& aut, Reduction reduce = {}) : aut_{ aut }, reduce_{ std::move(reduce) } {}
+
+        const StateSet& macrostate(const size_t id) const { return macrostates_[id]; }
+        bool is_final(const size_t id) const { return is_final_[id]; }
+
+        /// Get the id of @p macrostate (of its reduction, if a reduction is given).
+        size_t intern(const StateSet& macrostate) {
+            if (const auto it{ ids_.find(macrostate) }; it != ids_.end()) { return it->second; }
+            StateSet stored{ reduce_ ? reduce_(macrostate) : macrostate };
+            if (stored != macrostate) {
+                // Reached macrostates are kept as keys as well, so that they are reduced only once.
+                if (const auto it{ ids_.find(stored) }; it != ids_.end()) {
+                    ids_.emplace(macrostate, it->second);
+                    return it->second;
+                }
+                ids_.emplace(macrostate, macrostates_.size());
+            }
+            const size_t id{ macrostates_.size() };
+            ids_.emplace(stored, id);
+            is_final_.push_back(aut_.final.intersects_with(stored));
+            macrostates_.push_back(std::move(stored));
+            posts_.emplace_back();
+            has_posts_.push_back(false);
+            return id;
+        }
+
+        /// Get the id of the successor of the macrostate with @p id over @p symbol.
+        size_t successor(const size_t id, const Symbol symbol) {
+            if (!has_posts_[id]) {
+                std::vector<std::pair<Symbol, StateSet>> targets{};
+                sync_iterator_.reset();
+                for (const State state: macrostates_[id]) { mata::utils::push_back(sync_iterator_, aut_.delta[state]); }
+                while (sync_iterator_.advance()) {
+                    targets.emplace_back(sync_iterator_.get_current()[0]->symbol, sync_iterator_.unify_targets());
+                }
+                std::vector<std::pair<Symbol, size_t>> id_posts{};
+                for (const auto& [post_symbol, post_targets]: targets) {
+                    id_posts.emplace_back(post_symbol, intern(post_targets));
+                }
+                posts_[id] = std::move(id_posts);
+                has_posts_[id] = true;
+            }
+            const auto& id_posts{ posts_[id] };
+            const auto it{ std::lower_bound(id_posts.begin(), id_posts.end(), symbol,
+                                            [](const auto& post, const Symbol s) { return post.first < s; }) };
+            if (it == id_posts.end() || it->first != symbol) { return intern(StateSet{}); }
+            return it->second;
+        }
+
+    private:
+        const Nfa& aut_;
+        Reduction reduce_;
+        std::vector<StateSet> macrostates_{};
+        std::unordered_map<StateSet, size_t> ids_{};
+        /// Successors of macrostates over symbols, ordered by symbols.
+        std::vector<std::vector<std::pair<Symbol, size_t>>> posts_{};
+        std::vector<bool> has_posts_{};
+        std::vector<bool> is_final_{};
+        SynchronizedExistentialSymbolPostIterator sync_iterator_{};
+    };
+
+    /**
+     * Breadth-first search of pairs (q,S) of the product of @p smaller with the complement of @p bigger, where only
+     *  the reached pairs are stored.
+     * @return True iff no pair with q final and S non-final is reached, i.e., the language of @p smaller is included
+     *  in the language of @p bigger.
+     */
+    bool is_included_lazy(const Nfa& smaller, LazyDeterminization& bigger, const StateSet& bigger_initial, Run* cex) {
+        struct Pair { State state; size_t macrostate; size_t pair_id; };
+        std::deque<Pair> worklist{};
+        std::vector<std::unordered_set<size_t>> visited(smaller.num_of_states());
+        ProductStateParents parents{};
+        const size_t initial{ bigger.intern(bigger_initial) };
+        for (const State state: smaller.initial) {
+            if (smaller.final.contains(state) && !bigger.is_final(initial)) {
+                if (cex != nullptr) { cex->word.clear(); }
+                return false;
+            }
+            visited[state].insert(initial);
+            worklist.push_back({ state, initial, cex != nullptr ? parents.add_initial() : 0 });
+        }
+        while (!worklist.empty()) {
+            const Pair pair{ worklist.front() };
+            worklist.pop_front();
+            for (const SymbolPost& smaller_move: smaller.delta[pair.state]) {
+                const size_t succ{ bigger.successor(pair.macrostate, smaller_move.symbol) };
+                for (const State smaller_succ: smaller_move.targets) {
+                    if (smaller.final.contains(smaller_succ) && !bigger.is_final(succ)) {
+                        if (cex != nullptr) { cex->word = parents.get_word(pair.pair_id, smaller_move.symbol); }
+                        return false;
+                    }
+                    if (!visited[smaller_succ].insert(succ).second) { continue; }
+                    worklist.push_back(
+                        { smaller_succ, succ, cex != nullptr ? parents.add(pair.pair_id, smaller_move.symbol) : 0 });
+                }
+            }
+        }
+        return true;
+    }
+}
+
+/// naive language inclusion check with bigger determinized lazily along the words of smaller
+bool mata::nfa::algorithms::is_included_naive_lazy(
+        const Nfa& smaller,
+        const Nfa& bigger,
+        const Alphabet* const alphabet,
+        Run* cex) { // {{{
+    (void)alphabet;
+    LazyDeterminization bigger_determinization{ bigger };
+    return is_included_lazy(smaller, bigger_determinization, StateSet{ bigger.initial }, cex);
+} // is_included_naive_lazy }}}
+
+mata::nfa::algorithms::ExplorationOrder mata::nfa::algorithms::parse_exploration_order(const std::string& order) {
+    if (order == "dfs") { return ExplorationOrder::DFS; }
+    if (order == "bfs") { return ExplorationOrder::BFS; }
+    if (order == "smallest") { return ExplorationOrder::SMALLEST_MACROSTATE; }
+    if (order == "distance") { return ExplorationOrder::DISTANCE; }
+    throw std::runtime_error("unknown exploration order: \"" + order + "\"");
+}
+
 /// language inclusion check using Antichains
-// TODO, what about to construct the separator from this?
 bool mata::nfa::algorithms::is_included_antichains(
     const Nfa&             smaller,
     const Nfa&             bigger,
@@ -36,59 +251,370 @@ bool mata::nfa::algorithms::is_included_antichains(
     Run*                   cex)
 { // {{{
     (void)alphabet;
+    return is_included_antichains(smaller, bigger, ExplorationOrder::DFS, cex);
+} // }}}
 
-    // TODO: Decide what is the best optimization for inclusion.
+// TODO, what about to construct the separator from this?
+bool mata::nfa::algorithms::is_included_antichains(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const ExplorationOrder order,
+    Run*                   cex)
+{ // {{{
 
     using ProdStateType = std::tuple<State, StateSet, size_t>;
-    using ProdStatesType = std::vector<ProdStateType>;
-    // ProcessedType is indexed by states of the smaller nfa
+    // ProcessedType is indexed by states of the smaller nfa, it stores antichains of macrostates of the bigger nfa
+    // paired with the state.
     // tailored for pure antichain approach ... the simulation-based antichain will not work (without changes).
-    using ProcessedType = std::vector<ProdStatesType>;
+    using ProcessedType = std::vector<Antichain<StateSet>>;
+    // Pairs (q,id) of a state of the smaller nfa and an id of a macrostate in processed[q]. Pairs whose macrostates
+    // were removed from processed are skipped.
+    using WorklistType = Worklist<std::pair<State, Antichain<StateSet>::Id>>;
+
+    // initialize
+    WorklistType worklist{ get_worklist_order(order) };//Pairs (q,S) to be processed.
+    ProcessedType processed(smaller.num_of_states()); // Allocate to the number of states of the smaller nfa.
+
+    std::vector<State> distances_smaller = smaller.distances_to_final();
+    std::vector<State> distances_bigger = bigger.distances_to_final();
+
+    auto min_dst = [&](const StateSet& set) {
+        if (set.empty()) return Limits::max_state;
+        return distances_bigger[*std::min_element(set.begin(), set.end(), [&](const State a,const State b){return distances_bigger[a] < distances_bigger[b];})];
+    };
+
+    auto lengths_incompatible = [&](const ProdStateType& pair) {
+        return distances_smaller[std::get<0>(pair)] < std::get<2>(pair);
+    };
+
+    // Priority of a pair for the priority orders of the worklist, pairs with smaller priorities are processed first.
+    auto priority = [&](const State smaller_state, const StateSet& bigger_set) -> size_t {
+        switch (order) {
+            case ExplorationOrder::SMALLEST_MACROSTATE: return bigger_set.size();
+            case ExplorationOrder::DISTANCE: return distances_smaller[smaller_state];
+            default: return 0;
+        }
+    };
+
+    // Parents of pairs for counterexamples, 'pair_ids[q][id]' is the id of the pair (q,S) in 'parents', where 'id' is
+    // the id of S in processed[q].
+    ProductStateParents parents{};
+    std::vector<std::vector<size_t>> pair_ids(cex != nullptr ? smaller.num_of_states() : 0);
 
-    auto subsumes = [](const ProdStateType& lhs, const ProdStateType& rhs) {
-        if (std::get<0>(lhs) != std::get<0>(rhs)) {
+    // check initial states first // TODO: this would be done in the main loop as the first thing anyway?
+    for (const auto& state : smaller.initial) {
+        if (smaller.final[state] &&
+            are_disjoint(bigger.initial, bigger.final))
+        {
+            if (cex != nullptr) { cex->word.clear(); }
             return false;
         }
 
-        const StateSet& lhs_bigger = std::get<1>(lhs);
-        const StateSet& rhs_bigger = std::get<1>(rhs);
+        const StateSet bigger_state_set{ bigger.initial };
+        worklist.push({ state, processed[state].insert(bigger_state_set) }, priority(state, bigger_state_set));
+
+        if (cex != nullptr)
+            pair_ids[state].push_back(parents.add_initial());
+    }
+
+    //For synchronised iteration over the set of states
+    SynchronizedExistentialSymbolPostIterator sync_iterator;
+
+    while (!worklist.empty()) {
+        // get a next product state
+        const auto [smaller_state, bigger_id] = worklist.pop();
+        if (!processed[smaller_state].is_alive(bigger_id)) { continue; }
+
+        const StateSet bigger_set = processed[smaller_state].get(bigger_id);
+
+        sync_iterator.reset();
+        for (State q: bigger_set) {
+            mata::utils::push_back(sync_iterator, bigger.delta[q]);
+        }
+
+        // process transitions leaving smaller_state
+        for (const auto& smaller_move : smaller.delta[smaller_state]) {
+            const Symbol& smaller_symbol = smaller_move.symbol;
+
+            StateSet bigger_succ = {};
+            if(sync_iterator.synchronize_with(smaller_move)) {
+                bigger_succ = sync_iterator.unify_targets();
+            }
+
+            for (const State& smaller_succ : smaller_move.targets) {
+                const ProdStateType succ = {smaller_succ, bigger_succ, min_dst(bigger_succ)};
+
+                if (lengths_incompatible(succ) || (smaller.final[smaller_succ] &&
+                    !bigger.final.intersects_with(bigger_succ)))
+                {
+                    if (cex != nullptr) {
+                        cex->word = parents.get_word(pair_ids[smaller_state][bigger_id], smaller_symbol);
+                        append_shortest_word_to_final(smaller, smaller_succ, cex->word);
+                    }
+
+                    return false;
+                }
+
+                // Insert succ unless a pair with the same state of smaller and a subset of bigger_succ was processed,
+                // the pairs with supersets of bigger_succ are pruned.
+                const Antichain<StateSet>::Id succ_id{ processed[smaller_succ].insert(bigger_succ) };
+                if (succ_id == Antichain<StateSet>::NO_ID) {
+                    continue;
+                }
+                worklist.push({ smaller_succ, succ_id }, priority(smaller_succ, bigger_succ));
+
+                if(cex != nullptr) {
+                    // also set that succ was accessed from state
+                    assert(pair_ids[smaller_succ].size() == succ_id);
+                    pair_ids[smaller_succ].push_back(
+                        parents.add(pair_ids[smaller_state][bigger_id], smaller_symbol));
+                }
+            }
+        }
+    }
+    return true;
+} // }}}
+
+/// language inclusion check using antichains, explored by multiple threads
+bool mata::nfa::algorithms::is_included_antichains_parallel(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    size_t                 num_of_threads,
+    const ExplorationOrder order,
+    Run*                   cex)
+{ // {{{
+    num_of_threads = std::min(num_of_threads, mata::utils::MAX_NUM_OF_THREADS);
+    if (num_of_threads <= 1) { return is_included_antichains(smaller, bigger, order, cex); }
 
-        //TODO: Can this be done faster using more heuristics? E.g., compare the last elements first ...
-        //TODO: Try BDDs! What about some abstractions?
-        return lhs_bigger.is_subset_of(rhs_bigger);
+    // A pair (q,S) to be processed, given by the id of S in processed[q], and the id of the pair in 'parents'.
+    struct WorkItem {
+        State state;
+        Antichain<StateSet>::Id bigger_id;
+        size_t pair_id;
+    };
+    // Worklist of a thread. The owner pops the pairs in the exploration order, other threads steal them.
+    struct ThreadWorklist {
+        std::mutex mutex{};
+        Worklist<WorkItem> items{};
     };
 
+    // processed is shared by all threads, its antichains are locked by shards of states of the smaller nfa.
+    std::vector<Antichain<StateSet>> processed(smaller.num_of_states());
+    std::vector<std::mutex> shard_mutexes(std::clamp(smaller.num_of_states(), size_t{ 1 }, size_t{ 1024 }));
+    auto shard_mutex = [&](const State state) -> std::mutex& { return shard_mutexes[state % shard_mutexes.size()]; };
 
-    // initialize
-    ProdStatesType worklist{};//Pairs (q,S) to be processed. It sometimes gives a huge speed-up when they are kept sorted by the size of S,
-    // worklist.reserve(32);
-    // so those with smaller popped for processing first.
-    ProcessedType processed(smaller.num_of_states()); // Allocate to the number of states of the smaller nfa.
-    // The pairs of each state are also kept sorted. It allows slightly faster antichain pruning - no need to test inclusion in sets that have less elements.
+    std::vector<ThreadWorklist> worklists(num_of_threads);
+    for (ThreadWorklist& worklist: worklists) { worklist.items = Worklist<WorkItem>{ get_worklist_order(order) }; }
+    // Number of pairs pushed to worklists and not yet processed. Processing of a pair pushes its successors before
+    //  the pair is counted as processed, so all worklists are empty for good when the counter drops to zero.
+    std::atomic<size_t> pending{ 0 };
+    std::atomic<bool> stop{ false };
+    bool included{ true };
+    std::mutex result_mutex{};
+    std::mutex parents_mutex{};
+    ProductStateParents parents{};
+
+    std::vector<State> distances_smaller = smaller.distances_to_final();
+    std::vector<State> distances_bigger = bigger.distances_to_final();
+    auto min_dst = [&](const StateSet& set) {
+        State min_distance{ Limits::max_state };
+        for (const State state: set) { min_distance = std::min(min_distance, distances_bigger[state]); }
+        return min_distance;
+    };
+
+    // Priority of a pair for the priority orders, as in is_included_antichains().
+    auto priority = [&](const State smaller_state, const StateSet& bigger_set) -> size_t {
+        switch (order) {
+            case ExplorationOrder::SMALLEST_MACROSTATE: return bigger_set.size();
+            case ExplorationOrder::DISTANCE: return distances_smaller[smaller_state];
+            default: return 0;
+        }
+    };
+
+    auto push = [&](const size_t thread, const WorkItem& item, const StateSet& bigger_set) {
+        ++pending;
+        const std::lock_guard lock{ worklists[thread].mutex };
+        worklists[thread].items.push(item, priority(item.state, bigger_set));
+    };
+
+    auto pop = [&](const size_t thread) -> std::optional<WorkItem> {
+        for (size_t i{ 0 }; i < num_of_threads; ++i) {
+            ThreadWorklist& worklist{ worklists[(thread + i) % num_of_threads] };
+            const std::lock_guard lock{ worklist.mutex };
+            if (worklist.items.empty()) { continue; }
+            return i == 0 ? worklist.items.pop() : worklist.items.steal();
+        }
+        return std::nullopt;
+    };
 
-    //Is |S| < |S'| for the inut pairs (q,S) and (q',S')?
-    // auto smaller_set = [](const ProdStateType & a, const ProdStateType & b) { return std::get<1>(a).size() < std::get<1>(b).size(); };
+    auto report_violation = [&](const WorkItem& item, const Symbol symbol, const State smaller_succ) {
+        const std::lock_guard lock{ result_mutex };
+        if (!included) { return; }
+        included = false;
+        stop = true;
+        if (cex != nullptr) {
+            const std::lock_guard parents_lock{ parents_mutex };
+            cex->word = parents.get_word(item.pair_id, symbol);
+            append_shortest_word_to_final(smaller, smaller_succ, cex->word);
+        }
+    };
+
+    auto process = [&](const size_t thread, const WorkItem& item, SynchronizedExistentialSymbolPostIterator& sync_iterator) {
+        StateSet bigger_set;
+        {
+            const std::lock_guard lock{ shard_mutex(item.state) };
+            if (!processed[item.state].is_alive(item.bigger_id)) { return; }
+            bigger_set = processed[item.state].get(item.bigger_id);
+        }
 
-    std::vector<State> distances_smaller = revert(smaller).distances_from_initial();
-    std::vector<State> distances_bigger = revert(bigger).distances_from_initial();
+        sync_iterator.reset();
+        for (const State q: bigger_set) { mata::utils::push_back(sync_iterator, bigger.delta[q]); }
 
-    // auto closer_dist = [&](const ProdStateType & a, const ProdStateType & b) {
-    //     return distances_smaller[a.first] < distances_smaller[b.first];
-    // };
+        for (const auto& smaller_move : smaller.delta[item.state]) {
+            StateSet bigger_succ = {};
+            if (sync_iterator.synchronize_with(smaller_move)) { bigger_succ = sync_iterator.unify_targets(); }
+            const State bigger_succ_distance{ min_dst(bigger_succ) };
 
-    // auto closer_smaller = [&](const ProdStateType & a, const ProdStateType & b) {
-    //     if (distances_smaller[a.first] != distances_smaller[b.first])
-    //         return distances_smaller[a.first] < distances_smaller[b.first];
-    //     else
-    //         return a.second.size() < b.second.size();
-    // };
+            for (const State smaller_succ : smaller_move.targets) {
+                if (stop) { return; }
+                if (distances_smaller[smaller_succ] < bigger_succ_distance
+                    || (smaller.final[smaller_succ] && !bigger.final.intersects_with(bigger_succ))) {
+                    report_violation(item, smaller_move.symbol, smaller_succ);
+                    return;
+                }
 
-    // auto smaller_closer = [&](const ProdStateType & a, const ProdStateType & b) {
-    //     if (a.second.size() != b.second.size())
-    //         return a.second.size() < b.second.size();
-    //     else
-    //         return distances_smaller[a.first] < distances_smaller[b.first];
-    // };
+                Antichain<StateSet>::Id succ_id;
+                {
+                    const std::lock_guard lock{ shard_mutex(smaller_succ) };
+                    succ_id = processed[smaller_succ].insert(bigger_succ);
+                }
+                if (succ_id == Antichain<StateSet>::NO_ID) { continue; }
+
+                size_t succ_pair_id{ 0 };
+                if (cex != nullptr) {
+                    const std::lock_guard lock{ parents_mutex };
+                    succ_pair_id = parents.add(item.pair_id, smaller_move.symbol);
+                }
+                push(thread, { smaller_succ, succ_id, succ_pair_id }, bigger_succ);
+            }
+        }
+    };
+
+    size_t next_thread{ 0 };
+    for (const State state : smaller.initial) {
+        if (smaller.final[state] && are_disjoint(bigger.initial, bigger.final)) {
+            if (cex != nullptr) { cex->word.clear(); }
+            return false;
+        }
+        const StateSet bigger_initial{ bigger.initial };
+        const Antichain<StateSet>::Id bigger_id{ processed[state].insert(bigger_initial) };
+        push(next_thread, { state, bigger_id, cex != nullptr ? parents.add_initial() : 0 }, bigger_initial);
+        next_thread = (next_thread + 1) % num_of_threads;
+    }
+
+    std::vector<std::exception_ptr> exceptions(num_of_threads);
+    auto worker = [&](const size_t thread) {
+        try {
+            SynchronizedExistentialSymbolPostIterator sync_iterator;
+            while (!stop) {
+                const std::optional<WorkItem> item{ pop(thread) };
+                if (!item) {
+                    if (pending == 0) { return; }
+                    std::this_thread::yield();
+                    continue;
+                }
+                process(thread, *item, sync_iterator);
+                --pending;
+            }
+        } catch (...) {
+            exceptions[thread] = std::current_exception();
+            stop = true;
+        }
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(num_of_threads - 1);
+    for (size_t thread{ 1 }; thread < num_of_threads; ++thread) { threads.emplace_back(worker, thread); }
+    worker(0);
+    for (std::thread& thread: threads) { thread.join(); }
+    for (const std::exception_ptr& exception: exceptions) {
+        if (exception) { std::rethrow_exception(exception); }
+    }
+    return included;
+} // }}}
+
+/// language inclusion check using antichains pruned by forward simulation (Abdulla et al., When Simulation Meets
+///  Antichains, 2010)
+bool mata::nfa::algorithms::is_included_antichains_sim(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const Alphabet* const  alphabet,
+    Run*                   cex)
+{ // {{{
+    (void)alphabet;
+
+    // Forward simulation on the disjoint union of both automata, states of bigger are shifted by 'offset'.
+    const size_t offset{ smaller.num_of_states() };
+    const Simlib::Util::PartitionRelation simulation{ compute_partition_relation(disjoint_union(smaller, bigger)) };
+
+    // 'simulates(p, q)' iff state 'q' of the united automaton simulates state 'p'.
+    auto simulates = [&](const State p, const State q) { return simulation.get(p, q); };
+
+    // For each state of smaller, the states of smaller simulating it and the states of smaller it simulates, so that
+    //  the antichains are not scanned over all states of smaller for every generated pair.
+    std::vector<std::vector<State>> smaller_simulating(offset);
+    std::vector<std::vector<State>> smaller_simulated(offset);
+    for (State p{ 0 }; p < offset; ++p) {
+        for (State q{ 0 }; q < offset; ++q) {
+            if (simulates(p, q)) {
+                smaller_simulating[p].push_back(q);
+                smaller_simulated[q].push_back(p);
+            }
+        }
+    }
+
+    // Keep only the states of a macrostate which are not simulated by another state of the macrostate (the smallest
+    //  state of each class of mutually similar states is kept).
+    auto minimize_macrostate = [&](const StateSet& macrostate) {
+        StateSet minimized{};
+        for (const State s: macrostate) {
+            const bool dominated = std::any_of(macrostate.begin(), macrostate.end(), [&](const State t) {
+                if (s == t || !simulates(s + offset, t + offset)) { return false; }
+                return !simulation.sym(s + offset, t + offset) || t < s;
+            });
+            if (!dominated) { minimized.push_back(s); }
+        }
+        return minimized;
+    };
+
+    // The language of 'smaller_state' is included in the language of 'macrostate' already.
+    auto simulated_by_macrostate = [&](const State smaller_state, const StateSet& macrostate) {
+        return std::any_of(macrostate.begin(), macrostate.end(),
+                           [&](const State s) { return simulates(smaller_state, s + offset); });
+    };
+
+    // Pairs (q,S) with the minimal distance of S to final states and the id of the pair in 'parents'.
+    using ProdStateType = std::tuple<State, StateSet, size_t, size_t>;
+    using ProdStatesType = std::vector<ProdStateType>;
+    // ProcessedType is indexed by states of the smaller nfa.
+    using ProcessedType = std::vector<ProdStatesType>;
+
+    // 'lhs' subsumes 'rhs' if 'lhs' reaches a counterexample whenever 'rhs' does: the state of smaller in 'lhs'
+    //  simulates the one in 'rhs' and each state of the macrostate in 'lhs' is simulated by a state in 'rhs'.
+    auto subsumes = [&](const ProdStateType& lhs, const ProdStateType& rhs) {
+        if (!simulates(std::get<0>(rhs), std::get<0>(lhs))) { return false; }
+        const StateSet& rhs_bigger = std::get<1>(rhs);
+        return std::all_of(std::get<1>(lhs).begin(), std::get<1>(lhs).end(), [&](const State s) {
+            return std::any_of(rhs_bigger.begin(), rhs_bigger.end(),
+                               [&](const State t) { return simulates(s + offset, t + offset); });
+        });
+    };
+
+    ProdStatesType worklist{};
+    ProcessedType processed(smaller.num_of_states());
+
+    std::vector<State> distances_smaller = smaller.distances_to_final();
+    std::vector<State> distances_bigger = bigger.distances_to_final();
 
     auto min_dst = [&](const StateSet& set) {
         if (set.empty()) return Limits::max_state;
@@ -99,21 +625,10 @@ bool mata::nfa::algorithms::is_included_antichains(
         return distances_smaller[std::get<0>(pair)] < std::get<2>(pair);
     };
 
-    auto insert_to_pairs = [&](ProdStatesType & pairs,const ProdStateType & pair) {
-        // auto it = std::lower_bound(pairs.begin(), pairs.end(), pair, smaller_set);
-        // auto it = std::lower_bound(pairs.begin(), pairs.end(), pair, closer_dist);
-        // auto it = std::lower_bound(pairs.begin(), pairs.end(), pair, smaller_closer);
-        // auto it = std::lower_bound(pairs.begin(), pairs.end(), pair, closer_smaller);
-        // pairs.insert(it,pair);
-        pairs.push_back(pair);
-        // std::sort(pairs.begin(), pairs.end(), smaller_closer);
-    };
-
-    // 'paths[s] == t' denotes that state 's' was accessed from state 't',
-    // 'paths[s] == s' means that 's' is an initial state
-    std::map<ProdStateType, std::pair<ProdStateType, Symbol>> paths;
+    // Parents of pairs for counterexamples.
+    ProductStateParents parents{};
 
-    // check initial states first // TODO: this would be done in the main loop as the first thing anyway?
+    const StateSet bigger_initial{ minimize_macrostate(StateSet{ bigger.initial }) };
     for (const auto& state : smaller.initial) {
         if (smaller.final[state] &&
             are_disjoint(bigger.initial, bigger.final))
@@ -121,14 +636,12 @@ bool mata::nfa::algorithms::is_included_antichains(
             if (cex != nullptr) { cex->word.clear(); }
             return false;
         }
+        if (simulated_by_macrostate(state, bigger_initial)) { continue; }
 
-        StateSet bigger_state_set{ bigger.initial };
-        const ProdStateType st = std::tuple(state, bigger_state_set, min_dst(bigger_state_set));
-        insert_to_pairs(worklist, st);
-        insert_to_pairs(processed[state],st);
-
-        if (cex != nullptr)
-            paths.insert({ st, {st, 0}});
+        const size_t pair_id{ cex != nullptr ? parents.add_initial() : 0 };
+        const ProdStateType st = std::tuple(state, bigger_initial, min_dst(bigger_initial), pair_id);
+        worklist.push_back(st);
+        processed[state].push_back(st);
     }
 
     //For synchronised iteration over the set of states
@@ -136,7 +649,6 @@ bool mata::nfa::algorithms::is_included_antichains(
 
     // We use DFS strategy for the worklist processing
     while (!worklist.empty()) {
-        // get a next product state
         ProdStateType prod_state = *worklist.rbegin();
         worklist.pop_back();
 
@@ -148,79 +660,269 @@ bool mata::nfa::algorithms::is_included_antichains(
             mata::utils::push_back(sync_iterator, bigger.delta[q]);
         }
 
-        // process transitions leaving smaller_state
         for (const auto& smaller_move : smaller.delta[smaller_state]) {
             const Symbol& smaller_symbol = smaller_move.symbol;
 
             StateSet bigger_succ = {};
             if(sync_iterator.synchronize_with(smaller_move)) {
-                bigger_succ = sync_iterator.unify_targets();
+                bigger_succ = minimize_macrostate(sync_iterator.unify_targets());
             }
 
             for (const State& smaller_succ : smaller_move.targets) {
-                const ProdStateType succ = {smaller_succ, bigger_succ, min_dst(bigger_succ)};
+                // Minimization of macrostates preserves both final states and the minimal distance to them, since
+                //  a state is simulated only by final states if it is final and by closer states to final states.
+                ProdStateType succ = {smaller_succ, bigger_succ, min_dst(bigger_succ), 0};
 
                 if (lengths_incompatible(succ) || (smaller.final[smaller_succ] &&
                     !bigger.final.intersects_with(bigger_succ)))
                 {
                     if (cex != nullptr) {
-                        cex->word.clear();
-                        cex->word.push_back(smaller_symbol);
-                        ProdStateType trav = prod_state;
-                        while (paths[trav].first != trav)
-                        { // go back until initial state
-                            cex->word.push_back(paths[trav].second);
-                            trav = paths[trav].first;
-                        }
-
-                        std::reverse(cex->word.begin(), cex->word.end());
+                        cex->word = parents.get_word(std::get<3>(prod_state), smaller_symbol);
+                        append_shortest_word_to_final(smaller, smaller_succ, cex->word);
                     }
 
                     return false;
                 }
 
-                bool is_subsumed = false;
-                for (const auto& anti_state : processed[smaller_succ])
-                { // trying to find in processed a smaller state than the newly created succ
-                    // if (smaller_set(succ,anti_state)) {
-                    //     break;
-                    // }
-                    if (subsumes(anti_state, succ)) {
-                        is_subsumed = true;
-                        break;
-                    }
-                }
+                if (simulated_by_macrostate(smaller_succ, bigger_succ)) { continue; }
 
+                const bool is_subsumed = std::any_of(
+                    smaller_simulating[smaller_succ].begin(), smaller_simulating[smaller_succ].end(),
+                    [&](const State p) {
+                        return std::any_of(processed[p].begin(), processed[p].end(),
+                                           [&](const ProdStateType& anti_state) { return subsumes(anti_state, succ); });
+                    });
                 if (is_subsumed) {
                     continue;
                 }
 
-                for (ProdStatesType* ds: {&processed[smaller_succ], &worklist}) {
-                    //Pruning of processed and the worklist.
-                    //Since they are ordered by the size of the sets, we can iterate from back,
-                    //and as soon as we get to sets larger than succ, we can stop (larger sets cannot be subsets).
-                    std::erase_if(*ds, [&](const auto& d){ return subsumes(succ, d); });
-                    // for (long it = static_cast<long>(ds->size()-1);it>=0;--it) {
-                    //     // if (smaller_set((*ds)[static_cast<size_t>(it)],succ))
-                    //         // break;
-                    //     if (subsumes(succ, (*ds)[static_cast<size_t>(it)])) {
-                    //         //Using index it instead of an iterator since erase could invalidate it (?)
-                    //         ds->erase(ds->begin() + it);
-                    //     }
-                    // }
-                    insert_to_pairs(*ds, succ);
-                }
-
                 if(cex != nullptr) {
                     // also set that succ was accessed from state
-                    paths[succ] = {prod_state, smaller_symbol};
+                    std::get<3>(succ) = parents.add(std::get<3>(prod_state), smaller_symbol);
+                }
+
+                for (const State p: smaller_simulated[smaller_succ]) {
+                    std::erase_if(processed[p], [&](const auto& d){ return subsumes(succ, d); });
                 }
+                std::erase_if(worklist, [&](const auto& d){ return subsumes(succ, d); });
+                processed[smaller_succ].push_back(succ);
+                worklist.push_back(std::move(succ));
             }
         }
     }
     return true;
 } // }}}
 
+namespace {
+    /**
+     * Congruence closure of a relation on macrostates: the smallest equivalence containing the relation which is
+     *  closed under union of macrostates.
+     *
+     * Membership is checked by rewriting (Bonchi and Pous, Checking NFA equivalence with bisimulations up to
+     *  congruence, 2013): a macrostate containing one side of a related pair is extended by the other side. Two
+     *  macrostates are in the closure iff their normal forms coincide, that is, iff each of them is included in the
+     *  normal form of the other one.
+     */
+    class CongruenceClosure {
+    public:
+        void add(const StateSet& lhs, const StateSet& rhs) { rules_.emplace_back(lhs, rhs); }
+
+        bool contains(const StateSet& lhs, const StateSet& rhs) const {
+            return lhs == rhs || (rewrites_to_superset(rhs, lhs) && rewrites_to_superset(lhs, rhs));
+        }
+
+    private:
+        std::vector<std::pair<StateSet, StateSet>> rules_{};
+
+        /// Whether the normal form of @p macrostate includes @p target. Rewriting stops as soon as it does.
+        bool rewrites_to_superset(StateSet macrostate, const StateSet& target) const {
+            bool changed{ true };
+            while (!target.is_subset_of(macrostate) && changed) {
+                changed = false;
+                for (const auto& [rule_lhs, rule_rhs]: rules_) {
+                    const bool has_lhs{ rule_lhs.is_subset_of(macrostate) };
+                    if (has_lhs != rule_rhs.is_subset_of(macrostate)) {
+                        macrostate.insert(has_lhs ? rule_rhs : rule_lhs);
+                        changed = true;
+                    }
+                }
+            }
+            return target.is_subset_of(macrostate);
+        }
+    };
+
+    /// Successors of the states in @p macrostate grouped by symbols, ordered by symbols.
+    std::vector<std::pair<Symbol, StateSet>> symbol_posts_of(
+        const Nfa& aut, const StateSet& macrostate, SynchronizedExistentialSymbolPostIterator& sync_iterator) {
+        std::vector<std::pair<Symbol, StateSet>> posts{};
+        sync_iterator.reset();
+        for (const State state: macrostate) { mata::utils::push_back(sync_iterator, aut.delta[state]); }
+        while (sync_iterator.advance()) {
+            posts.emplace_back(sync_iterator.get_current()[0]->symbol, sync_iterator.unify_targets());
+        }
+        return posts;
+    }
+
+    /**
+     * Check that macrostates @p lhs and @p rhs of @p aut accept the same language by the HKC algorithm: pairs of
+     *  macrostates reached over the same word are explored in the breadth-first order, skipping pairs in the
+     *  congruence closure of the pairs explored so far.
+     * @param[out] cex A shortest word accepted from exactly one of the macrostates, if they are not equivalent.
+     */
+    bool bisimilar_up_to_congruence(const Nfa& aut, const StateSet& lhs, const StateSet& rhs, Run* cex) {
+        struct PairNode {
+            StateSet lhs;
+            StateSet rhs;
+            size_t parent; ///< Index of the pair this pair was reached from, the root is its own parent.
+            Symbol symbol; ///< Symbol this pair was reached over from its parent.
+        };
+        std::vector<PairNode> pairs{ { lhs, rhs, 0, 0 } };
+        CongruenceClosure closure{};
+        SynchronizedExistentialSymbolPostIterator sync_iterator{};
+
+        // The pairs to process are the pairs with indices starting from 'next'.
+        for (size_t next{ 0 }; next < pairs.size(); ++next) {
+            const StateSet pair_lhs{ pairs[next].lhs };
+            const StateSet pair_rhs{ pairs[next].rhs };
+            if (closure.contains(pair_lhs, pair_rhs)) { continue; }
+
+            if (aut.final.intersects_with(pair_lhs) != aut.final.intersects_with(pair_rhs)) {
+                if (cex != nullptr) {
+                    cex->word.clear();
+                    for (size_t index{ next }; pairs[index].parent != index; index = pairs[index].parent) {
+                        cex->word.push_back(pairs[index].symbol);
+                    }
+                    std::reverse(cex->word.begin(), cex->word.end());
+                }
+                return false;
+            }
+            closure.add(pair_lhs, pair_rhs);
+
+            const auto lhs_posts{ symbol_posts_of(aut, pair_lhs, sync_iterator) };
+            const auto rhs_posts{ symbol_posts_of(aut, pair_rhs, sync_iterator) };
+            auto lhs_it{ lhs_posts.begin() };
+            auto rhs_it{ rhs_posts.begin() };
+            while (lhs_it != lhs_posts.end() || rhs_it != rhs_posts.end()) {
+                if (rhs_it == rhs_posts.end() || (lhs_it != lhs_posts.end() && lhs_it->first < rhs_it->first)) {
+                    pairs.push_back({ lhs_it->second, {}, next, lhs_it->first });
+                    ++lhs_it;
+                } else if (lhs_it == lhs_posts.end() || rhs_it->first < lhs_it->first) {
+                    pairs.push_back({ {}, rhs_it->second, next, rhs_it->first });
+                    ++rhs_it;
+                } else {
+                    pairs.push_back({ lhs_it->second, rhs_it->second, next, lhs_it->first });
+                    ++lhs_it;
+                    ++rhs_it;
+                }
+            }
+        }
+        return true;
+    }
+} // namespace.
+
+/// language inclusion check using bisimulation up to congruence: L(smaller) <= L(bigger) iff L(smaller) + L(bigger)
+///  == L(bigger)
+bool mata::nfa::algorithms::is_included_congruence(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const Alphabet* const  alphabet,
+    Run*                   cex)
+{ // {{{
+    (void)alphabet;
+    const Nfa united{ disjoint_union(smaller, bigger) };
+    StateSet bigger_initial{};
+    for (const State state: bigger.initial) { bigger_initial.insert(state + smaller.num_of_states()); }
+    return bisimilar_up_to_congruence(united, StateSet{ united.initial }, bigger_initial, cex);
+} // }}}
+
+bool mata::nfa::algorithms::are_equivalent_congruence(const Nfa& lhs, const Nfa& rhs, Run* cex) {
+    const Nfa united{ disjoint_union(lhs, rhs) };
+    StateSet lhs_initial{ lhs.initial };
+    StateSet rhs_initial{};
+    for (const State state: rhs.initial) { rhs_initial.insert(state + lhs.num_of_states()); }
+    return bisimilar_up_to_congruence(united, lhs_initial, rhs_initial, cex);
+}
+
+bool mata::nfa::algorithms::are_equivalent_hopcroft_karp(const Nfa& lhs, const Nfa& rhs, Run* cex) {
+    if (!lhs.is_deterministic() || !rhs.is_deterministic()) {
+        throw std::runtime_error(std::to_string(__func__) + " requires deterministic automata");
+    }
+
+    // States of the disjoint union of lhs and rhs, with states of rhs shifted by 'offset', and a non-final sink
+    //  state, which is the target of all missing transitions.
+    const size_t offset{ lhs.num_of_states() };
+    const State sink{ offset + rhs.num_of_states() };
+    auto post = [&](const State state, const SymbolPost& symbol_post) {
+        return state < offset ? symbol_post.targets.front() : symbol_post.targets.front() + offset;
+    };
+    auto state_post = [&](const State state) -> const StatePost& {
+        if (state == sink) { return Delta::empty_state_post; }
+        return state < offset ? lhs.delta[state] : rhs.delta[state - offset];
+    };
+    auto is_final = [&](const State state) {
+        if (state == sink) { return false; }
+        return state < offset ? lhs.final.contains(state) : rhs.final.contains(state - offset);
+    };
+
+    // Union-find over the states, with path halving.
+    std::vector<State> representative(sink + 1);
+    std::iota(representative.begin(), representative.end(), State{ 0 });
+    auto find = [&](State state) {
+        while (representative[state] != state) {
+            representative[state] = representative[representative[state]];
+            state = representative[state];
+        }
+        return state;
+    };
+
+    // Pairs of states reached over the same word, explored in the breadth-first order. 'parent' and 'symbol' of each
+    //  pair give the word, the initial pair is its own parent.
+    struct StatePair { State lhs; State rhs; size_t parent; Symbol symbol; };
+    std::vector<StatePair> pairs{ { *lhs.initial.begin(), *rhs.initial.begin() + offset, 0, 0 } };
+    representative[find(pairs[0].lhs)] = find(pairs[0].rhs);
+    for (size_t next{ 0 }; next < pairs.size(); ++next) {
+        const StatePair pair{ pairs[next] };
+        if (is_final(pair.lhs) != is_final(pair.rhs)) {
+            if (cex != nullptr) {
+                cex->word.clear();
+                for (size_t index{ next }; pairs[index].parent != index; index = pairs[index].parent) {
+                    cex->word.push_back(pairs[index].symbol);
+                }
+                std::reverse(cex->word.begin(), cex->word.end());
+            }
+            return false;
+        }
+
+        // Merge the posts of both states, missing transitions go to the sink.
+        const StatePost& lhs_post{ state_post(pair.lhs) };
+        const StatePost& rhs_post{ state_post(pair.rhs) };
+        auto lhs_it{ lhs_post.begin() };
+        auto rhs_it{ rhs_post.begin() };
+        while (lhs_it != lhs_post.end() || rhs_it != rhs_post.end()) {
+            Symbol symbol;
+            State lhs_succ{ sink };
+            State rhs_succ{ sink };
+            if (rhs_it == rhs_post.end() || (lhs_it != lhs_post.end() && lhs_it->symbol < rhs_it->symbol)) {
+                symbol = lhs_it->symbol;
+                lhs_succ = post(pair.lhs, *lhs_it++);
+            } else if (lhs_it == lhs_post.end() || rhs_it->symbol < lhs_it->symbol) {
+                symbol = rhs_it->symbol;
+                rhs_succ = post(pair.rhs, *rhs_it++);
+            } else {
+                symbol = lhs_it->symbol;
+                lhs_succ = post(pair.lhs, *lhs_it++);
+                rhs_succ = post(pair.rhs, *rhs_it++);
+            }
+            const State lhs_class{ find(lhs_succ) };
+            const State rhs_class{ find(rhs_succ) };
+            if (lhs_class == rhs_class) { continue; }
+            representative[lhs_class] = rhs_class;
+            pairs.push_back({ lhs_succ, rhs_succ, next, symbol });
+        }
+    }
+    return true;
+}
+
 namespace {
     using AlgoType = decltype(algorithms::is_included_naive)*;
 
@@ -246,8 +948,14 @@ namespace {
         const std::string &str_algo = params.at("algorithm");
         if ("naive" == str_algo) {
             algo = algorithms::is_included_naive;
+        } else if ("naive-lazy" == str_algo) {
+            algo = algorithms::is_included_naive_lazy;
         } else if ("antichains" == str_algo) {
             algo = algorithms::is_included_antichains;
+        } else if ("antichains-sim" == str_algo) {
+            algo = algorithms::is_included_antichains_sim;
+        } else if ("congruence" == str_algo) {
+            algo = algorithms::is_included_congruence;
         } else {
             throw std::runtime_error(std::to_string(__func__) +
                                      " received an unknown value of the \"algo\" key: " + str_algo);
@@ -266,14 +974,38 @@ bool mata::nfa::is_included(
         const Alphabet *const alphabet,
         const ParameterMap &params) { // {{{
     AlgoType algo{set_algorithm(std::to_string(__func__), params)};
+    if (params.at("algorithm") == "antichains" && (haskey(params, "threads") || haskey(params, "exploration"))) {
+        const algorithms::ExplorationOrder order{
+            haskey(params, "exploration") ? algorithms::parse_exploration_order(params.at("exploration"))
+                                          : algorithms::ExplorationOrder::DFS };
+        if (haskey(params, "threads")) {
+            return algorithms::is_included_antichains_parallel(
+                smaller, bigger, parse_num_of_threads(params.at("threads")), order, cex);
+        }
+        return algorithms::is_included_antichains(smaller, bigger, order, cex);
+    }
     return algo(smaller, bigger, alphabet, cex);
 } // is_included }}}
 
 bool mata::nfa::are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet *alphabet, const ParameterMap& params)
 {
+    if (haskey(params, "algorithm") && params.at("algorithm") == "hopcroft-karp") {
+        return algorithms::are_equivalent_hopcroft_karp(lhs, rhs);
+    }
+
     //TODO: add comment on what this is doing, what is __func__ ...
     AlgoType algo{ set_algorithm(std::to_string(__func__), params) };
 
+    if (params.at("algorithm") == "antichains" && lhs.is_deterministic() && rhs.is_deterministic()) {
+        // Deterministic automata need no antichains, the union-find check is near-linear.
+        return algorithms::are_equivalent_hopcroft_karp(lhs, rhs);
+    }
+
+    if (params.at("algorithm") == "congruence") {
+        // A single exploration of pairs of macrostates checks both inclusions.
+        return algorithms::are_equivalent_congruence(lhs, rhs);
+    }
+
     if (params.at("algorithm") == "naive") {
         if (alphabet == nullptr) {
             const auto computed_alphabet{create_alphabet(lhs, rhs) };
@@ -287,3 +1019,144 @@ bool mata::nfa::are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet *a
 bool mata::nfa::are_equivalent(const Nfa& lhs, const Nfa& rhs, const ParameterMap& params) {
     return are_equivalent(lhs, rhs, nullptr, params);
 }
+
+struct mata::nfa::InclusionChecker::Impl {
+    /// Macrostates of bigger interned with their successors, kept by a single thread.
+    struct Workspace {
+        LazyDeterminization determinization;
+        /// Minimal distances of the states of the macrostates to final states, indexed by the ids of macrostates.
+        std::vector<State> min_distances{};
+    };
+
+    Nfa bigger;
+    std::string algorithm;
+    /// Distances of states of bigger to final states.
+    std::vector<State> distances;
+    /// Forward simulation on bigger, used by "antichains-sim" only.
+    std::optional<Simlib::Util::PartitionRelation> simulation{};
+    std::vector<std::unique_ptr<Workspace>> workspaces{};
+
+    Impl(Nfa bigger_aut, std::string algorithm_name)
+        : bigger{ std::move(bigger_aut) }, algorithm{ std::move(algorithm_name) },
+          distances{ bigger.distances_to_final() } {
+        distances.resize(bigger.num_of_states(), Limits::max_state);
+        if (algorithm == "antichains-sim") { simulation = algorithms::compute_partition_relation(bigger); }
+        else if (algorithm != "naive" && algorithm != "antichains") {
+            throw std::runtime_error("InclusionChecker received an unknown value of the \"algo\" key: " + algorithm);
+        }
+    }
+
+    static std::string get_algorithm(const ParameterMap& params) {
+        if (!haskey(params, "algorithm")) {
+            throw std::runtime_error("InclusionChecker requires setting the \"algo\" key in the \"params\" argument; "
+                                     "received: " + std::to_string(params));
+        }
+        return params.at("algorithm");
+    }
+
+    Workspace& get_workspace(const size_t thread) {
+        while (workspaces.size() <= thread) {
+            LazyDeterminization::Reduction reduce{};
+            if (simulation) { reduce = [this](const StateSet& macrostate) { return reduce_by_simulation(macrostate); }; }
+            workspaces.push_back(std::make_unique<Workspace>(Workspace{ LazyDeterminization{ bigger, reduce } }));
+        }
+        return *workspaces[thread];
+    }
+
+    /// Remove from @p macrostate the states simulated by other states of @p macrostate.
+    StateSet reduce_by_simulation(const StateSet& macrostate) const {
+        StateSet reduced{};
+        for (const State s: macrostate) {
+            const bool dominated = std::any_of(macrostate.begin(), macrostate.end(), [&](const State t) {
+                if (s == t || !simulation->get(s, t)) { return false; }
+                return !simulation->sym(s, t) || t < s;
+            });
+            if (!dominated) { reduced.push_back(s); }
+        }
+        return reduced;
+    }
+
+    /// Get the minimal distance of the states of the macrostate with @p id to final states.
+    State min_distance(Workspace& workspace, const size_t id) const {
+        while (workspace.min_distances.size() <= id) {
+            State min_distance{ Limits::max_state };
+            for (const State state: workspace.determinization.macrostate(workspace.min_distances.size())) {
+                min_distance = std::min(min_distance, distances[state]);
+            }
+            workspace.min_distances.push_back(min_distance);
+        }
+        return workspace.min_distances[id];
+    }
+
+    bool check(Workspace& workspace, const Nfa& smaller, Run* cex) const {
+        LazyDeterminization& determinization{ workspace.determinization };
+        if (algorithm == "naive") { return is_included_lazy(smaller, determinization, StateSet{ bigger.initial }, cex); }
+
+        const size_t initial{ determinization.intern(StateSet{ bigger.initial }) };
+        ProductStateParents parents{};
+        // Antichain algorithm: depth-first search of pairs (q,S) pruned by pairs (q,S') with S' a subset of S.
+        struct Pair { State state; size_t macrostate; Antichain<StateSet>::Id antichain_id; size_t pair_id; };
+        std::vector<Pair> worklist{};
+        std::vector<Antichain<StateSet>> processed(smaller.num_of_states());
+        std::vector<State> distances_smaller{ smaller.distances_to_final() };
+        distances_smaller.resize(smaller.num_of_states(), Limits::max_state);
+        for (const State state: smaller.initial) {
+            if (smaller.final.contains(state) && !determinization.is_final(initial)) {
+                if (cex != nullptr) { cex->word.clear(); }
+                return false;
+            }
+            worklist.push_back({ state, initial, processed[state].insert(determinization.macrostate(initial)),
+                                 cex != nullptr ? parents.add_initial() : 0 });
+        }
+        while (!worklist.empty()) {
+            const Pair pair{ worklist.back() };
+            worklist.pop_back();
+            if (!processed[pair.state].is_alive(pair.antichain_id)) { continue; }
+            for (const SymbolPost& smaller_move: smaller.delta[pair.state]) {
+                const size_t succ{ determinization.successor(pair.macrostate, smaller_move.symbol) };
+                for (const State smaller_succ: smaller_move.targets) {
+                    if ((smaller.final.contains(smaller_succ) && !determinization.is_final(succ))
+                        || distances_smaller[smaller_succ] < min_distance(workspace, succ)) {
+                        if (cex != nullptr) {
+                            cex->word = parents.get_word(pair.pair_id, smaller_move.symbol);
+                            append_shortest_word_to_final(smaller, smaller_succ, cex->word);
+                        }
+                        return false;
+                    }
+                    const Antichain<StateSet>::Id succ_antichain_id{
+                        processed[smaller_succ].insert(determinization.macrostate(succ)) };
+                    if (succ_antichain_id == Antichain<StateSet>::NO_ID) { continue; }
+                    const size_t succ_pair_id{ cex != nullptr ? parents.add(pair.pair_id, smaller_move.symbol) : 0 };
+                    worklist.push_back({ smaller_succ, succ, succ_antichain_id, succ_pair_id });
+                }
+            }
+        }
+        return true;
+    }
+};
+
+mata::nfa::InclusionChecker::InclusionChecker(Nfa bigger, const ParameterMap& params)
+    : impl_{ std::make_unique<Impl>(std::move(bigger), Impl::get_algorithm(params)) } {}
+
+mata::nfa::InclusionChecker::InclusionChecker(InclusionChecker&& other) noexcept = default;
+mata::nfa::InclusionChecker& mata::nfa::InclusionChecker::operator=(InclusionChecker&& other) noexcept = default;
+mata::nfa::InclusionChecker::~InclusionChecker() = default;
+
+const Nfa& mata::nfa::InclusionChecker::get_bigger() const { return impl_->bigger; }
+
+bool mata::nfa::InclusionChecker::check(const Nfa& smaller, Run* cex) {
+    return impl_->check(impl_->get_workspace(0), smaller, cex);
+}
+
+std::vector<bool> mata::nfa::InclusionChecker::check_all(
+    const std::span<const Nfa* const> smaller, const size_t num_of_threads, std::vector<Run>* cexs) {
+    impl_->get_workspace(std::max(num_of_threads, size_t{ 1 }) - 1);
+    if (cexs != nullptr) { cexs->assign(smaller.size(), Run{}); }
+    // Not std::vector<bool>, which cannot be written from multiple threads.
+    std::vector<char> results(smaller.size());
+    mata::utils::parallel_for(smaller.size(), num_of_threads, [&](const size_t index, const size_t thread) {
+        Run* cex{ cexs != nullptr ? &(*cexs)[index] : nullptr };
+        results[index] = impl_->check(*impl_->workspaces[thread], *smaller[index], cex);
+    });
+    return { results.begin(), results.end() };
+}
@@ -2,7 +2,10 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <list>
+#include <numeric>
 #include <optional>
 #include <iterator>
 
@@ -10,6 +13,7 @@
 #include "mata/utils/sparse-set.hh"
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/utils/parallel.hh"
 #include <mata/simlib/explicit_lts.hh>
 
 using namespace mata::utils;
@@ -18,7 +22,6 @@ using mata::Symbol;
 using mata::Word;
 using mata::BoolVector;
 
-using StateBoolArray = std::vector<bool>; ///< Bool array for states in the automaton.
 
 const std::string mata::nfa::TYPE_NFA = "NFA";
 
@@ -29,40 +32,148 @@ const Symbol Limits::max_symbol;
 
 namespace {
     /**
-     * Compute reachability of states considering only specified states.
+     * Set of states represented by a dense bitset, with the range of its words which may contain set bits.
+     */
+    class StateBitset {
+    public:
+        using Word = uint64_t;
+        static constexpr size_t WORD_BITS{ 64 };
+
+        explicit StateBitset(const size_t num_of_states)
+            : words_((num_of_states + WORD_BITS - 1) / WORD_BITS, 0), begin_{ words_.size() } {}
+
+        bool contains(const State state) const {
+            // The words may be concurrently updated by insert() and std::atomic_ref requires a non-const object.
+            const std::atomic_ref<Word> word{ const_cast<Word&>(words_[state / WORD_BITS]) };
+            return (word.load(std::memory_order_relaxed) >> (state % WORD_BITS)) & 1;
+        }
+
+        /// Insert @p state, atomically if @p concurrent. Return whether @p state has not been in the set.
+        bool insert(const State state, const bool concurrent) {
+            const size_t index{ state / WORD_BITS };
+            const Word mask{ Word{ 1 } << (state % WORD_BITS) };
+            if (concurrent) {
+                return !(std::atomic_ref<Word>{ words_[index] }.fetch_or(mask, std::memory_order_relaxed) & mask);
+            }
+            if (words_[index] & mask) { return false; }
+            words_[index] |= mask;
+            return true;
+        }
+
+        /// Extend the range of words which may contain set bits by the range [@p begin, @p end).
+        void extend_range(const size_t begin, const size_t end) {
+            if (begin >= end) { return; }
+            begin_ = std::min(begin_, begin);
+            end_ = std::max(end_, end);
+        }
+
+        size_t range_begin() const { return begin_; }
+        size_t range_end() const { return end_; }
+        bool empty_range() const { return begin_ >= end_; }
+
+        /// Call @p func(state) for every state in the word with @p index.
+        template<class Func>
+        void for_each_in_word(const size_t index, Func&& func) const {
+            for (Word word{ words_[index] }; word != 0; word &= word - 1) {
+                func(index * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+            }
+        }
+
+        /// Remove all states, touching only the words in the range.
+        void clear() {
+            if (!empty_range()) { std::fill(words_.begin() + static_cast<long>(begin_), words_.begin() + static_cast<long>(end_), 0); }
+            begin_ = words_.size();
+            end_ = 0;
+        }
+
+        BoolVector to_bool_vector(const size_t num_of_states) const {
+            BoolVector result(num_of_states, false);
+            for (size_t index{ 0 }; index < words_.size(); ++index) {
+                for_each_in_word(index, [&](const State state) { result[state] = true; });
+            }
+            return result;
+        }
+
+    private:
+        std::vector<Word> words_;
+        size_t begin_;
+        size_t end_{ 0 };
+    };
+
+    /**
+     * Compute the states reachable from @p sources by a level-synchronous breadth-first search with dense bitset
+     *  frontiers.
      *
-     * @param[in] nfa NFA to compute reachability for.
-     * @param[in] states_to_consider State to consider as potentially reachable. If @c std::nullopt is used, all states
-     *  are considered as potentially reachable.
-     * @return Bool array for reachable states (from initial states): true for reachable, false for unreachable states.
+     * Every level scans only the range of words of the frontier containing its states, and the states of a frontier
+     *  are expanded in parallel when @p num_of_threads is greater than 1.
+     * @param[in] for_each_successor Function calling its second argument for every successor of its first argument.
+     * @param[in] is_allowed Only the states satisfying @p is_allowed are visited.
      */
-    StateBoolArray reachable_states(const Nfa& nfa,
-                                       const std::optional<const StateBoolArray>& states_to_consider = std::nullopt) {
-        std::vector<State> worklist{};
-        StateBoolArray reachable(nfa.num_of_states(), false);
-        for (const State state: nfa.initial) {
-            if (!states_to_consider.has_value() || states_to_consider.value()[state]) {
-                worklist.push_back(state);
-                reachable.at(state) = true;
+    template<class Sources, class ForEachSuccessor, class IsAllowed>
+    StateBitset compute_reachable(const size_t num_of_states, const Sources& sources,
+                                  const ForEachSuccessor& for_each_successor, const IsAllowed& is_allowed,
+                                  const size_t num_of_threads) {
+        StateBitset visited{ num_of_states };
+        StateBitset frontier{ num_of_states };
+        StateBitset next_frontier{ num_of_states };
+        for (const State state: sources) {
+            if (is_allowed(state) && visited.insert(state, false)) {
+                frontier.insert(state, false);
+                frontier.extend_range(state / StateBitset::WORD_BITS, state / StateBitset::WORD_BITS + 1);
             }
         }
 
-        State state;
-        while (!worklist.empty()) {
-            state = worklist.back();
-            worklist.pop_back();
-            for (const SymbolPost& move: nfa.delta[state]) {
-                for (const State target_state: move.targets) {
-                    if (!reachable[target_state] &&
-                        (!states_to_consider.has_value() || states_to_consider.value()[target_state])) {
-                        worklist.push_back(target_state);
-                        reachable[target_state] = true;
-                    }
-                }
+        // Ranges of words of the next frontier written by each thread.
+        std::vector<std::pair<size_t, size_t>> thread_ranges(std::max(size_t{ 1 }, num_of_threads));
+        while (!frontier.empty_range()) {
+            const size_t range_begin{ frontier.range_begin() };
+            const bool concurrent{ num_of_threads > 1 && frontier.range_end() - range_begin > 1 };
+            std::fill(thread_ranges.begin(), thread_ranges.end(), std::pair<size_t, size_t>{ num_of_states, 0 });
+            mata::utils::parallel_for(
+                frontier.range_end() - range_begin, concurrent ? num_of_threads : 1,
+                [&](const size_t offset, const size_t thread) {
+                    frontier.for_each_in_word(range_begin + offset, [&](const State state) {
+                        for_each_successor(state, [&](const State successor) {
+                            if (visited.contains(successor) || !is_allowed(successor)) { return; }
+                            if (!visited.insert(successor, concurrent)) { return; }
+                            next_frontier.insert(successor, concurrent);
+                            auto& [begin, end]{ thread_ranges[thread] };
+                            begin = std::min(begin, successor / StateBitset::WORD_BITS);
+                            end = std::max(end, successor / StateBitset::WORD_BITS + 1);
+                        });
+                    });
+                });
+            frontier.clear();
+            for (const auto& [begin, end]: thread_ranges) { next_frontier.extend_range(begin, end); }
+            std::swap(frontier, next_frontier);
+        }
+        return visited;
+    }
+
+    auto forward_successors(const Nfa& aut) {
+        return [&aut](const State state, const auto& func) {
+            for (const SymbolPost& symbol_post: aut.delta[state]) {
+                for (const State target: symbol_post.targets) { func(target); }
             }
+        };
+    }
+
+    auto backward_successors(const PredecessorIndex& index) {
+        return [&index](const State state, const auto& func) {
+            for (size_t i{ index.begins[state] }; i < index.begins[state + 1]; ++i) { func(index.sources[i]); }
+        };
+    }
+
+    StateSet to_state_set(const StateBitset& states, const size_t num_of_states) {
+        const BoolVector bool_vector{ states.to_bool_vector(num_of_states) };
+        StateSet result{ StateSet::with_reserved(bool_vector.count()) };
+        for (State state{ 0 }; state < num_of_states; ++state) {
+            if (bool_vector[state]) { result.push_back(state); }
         }
-        return reachable;
+        return result;
     }
+
+    constexpr auto ALL_STATES_ALLOWED = [](State) { return true; };
 }
 
 void Nfa::remove_epsilon(const Symbol epsilon)
@@ -70,61 +181,76 @@ void Nfa::remove_epsilon(const Symbol epsilon)
     *this = mata::nfa::remove_epsilon(*this, epsilon);
 }
 
-StateSet Nfa::get_reachable_states() const {
-    StateBoolArray reachable_bool_array{ reachable_states(*this) };
-
-    StateSet reachable_states{};
+StateSet Nfa::get_reachable_states(const size_t num_of_threads) const {
     const size_t num_of_states{ this->num_of_states() };
-    for (State original_state{ 0 }; original_state < num_of_states; ++original_state)
-    {
-        if (reachable_bool_array[original_state])
-        {
-            reachable_states.insert(original_state);
-        }
-    }
-
-    return reachable_states;
+    return to_state_set(
+        compute_reachable(num_of_states, initial, forward_successors(*this), ALL_STATES_ALLOWED, num_of_threads),
+        num_of_states);
 }
 
-StateSet Nfa::get_terminating_states() const
-{
-    return revert(*this).get_reachable_states();
+StateSet Nfa::get_terminating_states(const size_t num_of_threads) const {
+    const size_t num_of_states{ this->num_of_states() };
+    const PredecessorIndex predecessors{ *this, num_of_threads };
+    return to_state_set(
+        compute_reachable(num_of_states, final, backward_successors(predecessors), ALL_STATES_ALLOWED, num_of_threads),
+        num_of_states);
 }
 
-std::vector<State> Nfa::distances_from_initial() const {
-    std::vector<State> distances(num_of_states()+1, Limits::max_state);
-    BoolVector visited(num_of_states()+1, false);
-    std::deque<State> que;
-
-    for (State qi: initial) {
-        visited[qi] = true;
-        distances[qi] = 0;
-        que.push_back(qi);
+Nfa::CachedData& Nfa::get_cache() const {
+    auto is_same_set = [](const utils::SparseSet<State>& set, const std::vector<State>& cached) {
+        return set.size() == cached.size()
+               && std::all_of(cached.begin(), cached.end(), [&](const State state) { return set.contains(state); });
+    };
+    CachedData& cache{ cache_.data };
+    const size_t num_of_states{ this->num_of_states() };
+    if (cache.delta_version != delta.version() || cache.num_of_states != num_of_states
+        || !is_same_set(initial, cache.initial) || !is_same_set(final, cache.final)) {
+        cache = CachedData{};
+        cache.delta_version = delta.version();
+        cache.num_of_states = num_of_states;
+        cache.initial.assign(initial.begin(), initial.end());
+        cache.final.assign(final.begin(), final.end());
     }
+    return cache;
+}
 
-    while (!que.empty()) {
-        State src = que.front();
-        que.pop_front();
-        for (Move move : delta[src].moves()) {
-            if (!visited[move.target]) {
-                visited[move.target] = true;
-                distances[move.target] = distances[src] +1;
-                que.push_back(move.target);
+const std::vector<State>& Nfa::distances_from_initial() const {
+    return get_cached(&CachedData::distances_from_initial, [&]() {
+        std::vector<State> distances(num_of_states() + 1, Limits::max_state);
+        Traversal traversal{};
+        traversal.run(*this, initial);
+        for (const State state: traversal.visited_states()) { distances[state] = traversal.depth(state); }
+        return distances;
+    });
+}
+
+const std::vector<State>& Nfa::distances_to_final() const {
+    return get_cached(&CachedData::distances_to_final, [&]() {
+        // Breadth-first search from the final states over the predecessors, the worklist is the vector of the
+        //  discovered states.
+        std::vector<State> distances(num_of_states() + 1, Limits::max_state);
+        const PredecessorIndex predecessors{ *this };
+        std::vector<State> discovered{};
+        discovered.reserve(num_of_states());
+        for (const State state: final) {
+            distances[state] = 0;
+            discovered.push_back(state);
+        }
+        for (size_t head{ 0 }; head < discovered.size(); ++head) {
+            const State state{ discovered[head] };
+            for (size_t i{ predecessors.begins[state] }; i < predecessors.begins[state + 1]; ++i) {
+                const State predecessor{ predecessors.sources[i] };
+                if (distances[predecessor] != Limits::max_state) { continue; }
+                distances[predecessor] = distances[state] + 1;
+                discovered.push_back(predecessor);
             }
         }
-    }
-
-    return distances;
+        return distances;
+    });
 }
 
-Nfa& Nfa::trim(StateRenaming* state_renaming) {
-#ifdef _STATIC_STRUCTURES_
-    BoolVector useful_states{ useful_states() };
-    useful_states.clear();
-    useful_states = useful_states();
-#else
-    BoolVector useful_states{ get_useful_states() };
-#endif
+Nfa& Nfa::trim(StateRenaming* state_renaming, const size_t num_of_threads) {
+    BoolVector useful_states{ get_useful_states(num_of_threads) };
     const size_t useful_states_size{ useful_states.size() };
     std::vector<State> renaming(useful_states_size);
     for(State new_state{ 0 }, orig_state{ 0 }; orig_state < useful_states_size; ++orig_state) {
@@ -156,255 +282,73 @@ Nfa& Nfa::trim(StateRenaming* state_renaming) {
     return *this;
 }
 
-namespace {
-    // A structure to store metadata related to each state/node during the computation
-    // of useful states. It contains Tarjan's metadata and the state of the
-    // iteration through the successors.
-    struct TarjanNodeData {
-        StatePost::Moves::const_iterator current_move{};
-        StatePost::Moves::const_iterator end_move{};
-        // index of a node (corresponds to the time of discovery)
-        unsigned long index{ 0 };
-        // index of a lower node in the same SCC
-        unsigned long lowlink{ 0 };
-        // was the node already initialized (=the initial phase of the Tarjan's recursive call was executed)
-        bool initilized{ false };
-        // is node on Tarjan's stack?
-        bool on_stack{ false };
-
-        TarjanNodeData() = default;
-
-        TarjanNodeData(State q, const Delta& delta, unsigned long index)
-            : index(index), lowlink(index), initilized(true), on_stack(true) {
-            const StatePost::Moves moves{ delta[q].moves() };
-            current_move = moves.begin();
-            end_move = moves.end();
-        };
-    };
-};
-
-/**
- * @brief This function employs non-recursive version of Tarjan's algorithm for finding SCCs
- * (see https://en.wikipedia.org/wiki/Tarjan%27s_strongly_connected_components_algorithm, in particular strongconnect(v))
- * The method saturates a bool vector @p reached_and_reaching in a way that reached_and_reaching[i] = true iff
- * the state i is useful at the end. To break the recursiveness, we use @p program_stack simulating
- * the program stack during the recursive calls of strongconnect(v) (see the wiki).
- *
- * Node data
- *  - lowlink, index, on_stack (the same as from strongconnect(v))
- *  - initialized (flag denoting whether the node started to be processing in strongconnect)
- *  - bunch of iterators allowing to iterate over successors (and store the state of the iteration)
- *
- * Program stack @p program_stack
- *  - contains nodes
- *  - node on the top is being currently processed
- *  - node is removed after it has been completely processed (after the end of strongconnect)
- *
- * Simulation of strongconnect( @p act_state = v )
- *  - if @p act_state is not initialized yet (corresponds to the initial phase of strongconnect), initialize
- *  - if @p act_state has already been initialized (i.e., processing of @p act_state was resumed by a
- *    recursive call, which already finished and we continue in processing of @p act_state ), we set
- *    @p act_state lowlink to min of current lowlink and the current successor @p act_succ of @p act_state.
- *    @p act_succ corresponds to w in strongconnect(v). In particular, in strongconnect(v) we called
- *    strongconnect(w) and now we continue after the return.
- *  - Then, we continue iterating over successors @p next_state of @p act_state:
- *      * if @p next_state is not initialized (corresponds to the first if in strongconnect(v)), we simulate
- *        the recursive call of strongconnect( @p next_state ): we put @p next_state on @p program_stack and
- *        jump to the processing of a new node from @p program_stack (we do not remove @p act_state from program
- *        stack yet).
- *      * otherwise update the lowlink
- *  - The rest corresponds to the last part of strongconnect(v) with a difference that if a node in the closed
- *    SCC if useful, we declare all nodes in the SCC useful and moreover we propagate usefulness also the states
- *    in @p tarjan_stack as it contains states that can reach this closed SCC.
- *
- */
-void Nfa::tarjan_scc_discover(const TarjanDiscoverCallback& callback) const {
-    std::vector<TarjanNodeData> node_info(this->num_of_states());
-    std::vector<State> program_stack;
-    std::vector<State> tarjan_stack;
-    unsigned long index_cnt = 0;
-
-    for(const State& q0 : initial) {
-        program_stack.push_back(q0);
-    }
-
-    while(!program_stack.empty()) {
-        State act_state = program_stack.back();
-        TarjanNodeData& act_state_data = node_info[act_state];
-
-        // if a node is initialized and is not on stack --> skip it; this state was
-        // already processed (=this state is initial and was reachable from another initial).
-        if(act_state_data.initilized && !act_state_data.on_stack) {
-            program_stack.pop_back();
-            continue;
-        }
-
-        // node has not been initialized yet --> corresponds to the first call of strongconnect(act_state)
-        if(!act_state_data.initilized) {
-            // initialize node
-            act_state_data = TarjanNodeData(act_state, this->delta, index_cnt++);
-            tarjan_stack.push_back(act_state);
-
-            if(callback.state_discover && callback.state_discover(act_state)) {
-                return;
-            }
-        } else { // return from the recursive call
-            State act_succ = act_state_data.current_move->target;
-            act_state_data.lowlink = std::min(act_state_data.lowlink, node_info[act_succ].lowlink);
-            // act_succ is the state that cased the recursive call. Move to another successor.
-            ++act_state_data.current_move;
-        }
-
-        // iterate through outgoing edges
-        State next_state;
-        // rec_call simulates call of the strongconnect. Since c++ cannot do continue over
-        // multiple loops, we use rec_call to jump to the main loop
-        bool rec_call = false;
-        for(; act_state_data.current_move != act_state_data.end_move; ++act_state_data.current_move) {
-            next_state = act_state_data.current_move->target;
-            if(callback.succ_state_discover) {
-                callback.succ_state_discover(act_state, next_state);
-            }
-            if(!node_info[next_state].initilized) { // recursive call
-                program_stack.push_back(next_state);
-                rec_call = true;
-                break;
-            } else if(node_info[next_state].on_stack) {
-                act_state_data.lowlink = std::min(act_state_data.lowlink, node_info[next_state].index);
-            }
-        }
-        if(rec_call) continue;
-
-        // check if we have the root of a SCC
-        if(act_state_data.lowlink == act_state_data.index) {
-            State st;
-            std::vector<State> scc;
-            do {
-                st = tarjan_stack.back();
-                tarjan_stack.pop_back();
-                node_info[st].on_stack = false;
-
-                if(callback.scc_state_discover) {
-                    callback.scc_state_discover(st);
-                }
-                scc.push_back(st);
-            } while(st != act_state);
-            if(callback.scc_discover && callback.scc_discover(scc, tarjan_stack)) {
-                return;
-            }
-        }
-        // all successors have been processed, we can remove act_state from the program stack
-        program_stack.pop_back();
-    }
+BoolVector Nfa::get_useful_states(const size_t num_of_threads) const {
+    return get_cached(&CachedData::useful_states, [&]() {
+        // Terminating states are searched backward from final states among the reachable states only.
+        const size_t num_of_states{ this->num_of_states() };
+        const StateBitset reachable{
+            compute_reachable(num_of_states, initial, forward_successors(*this), ALL_STATES_ALLOWED, num_of_threads) };
+        const PredecessorIndex predecessors{ *this, num_of_threads };
+        return compute_reachable(num_of_states, final, backward_successors(predecessors),
+                                 [&](const State state) { return reachable.contains(state); }, num_of_threads)
+            .to_bool_vector(num_of_states);
+    });
 }
 
-BoolVector Nfa::get_useful_states() const {
-    BoolVector useful(this->num_of_states(), false);
-    bool final_scc = false;
-
-    TarjanDiscoverCallback callback {};
-    callback.state_discover = [&](State state) -> bool {
-        if(this->final.contains(state)) {
-            useful[state] = true;
-        }
-        return false;
-    };
-    callback.scc_discover = [&](const std::vector<State>& scc, const std::vector<State>& tarjan_stack) -> bool {
-        if(final_scc) {
-            // Propagate usefulness to the closed SCC.
-            for(const State& st: scc) { useful[st] = true; }
-            // Propagate usefulness to predecessors in @p tarjan_stack.
-            for (auto state_it{ tarjan_stack.rbegin() }, state_it_end{ tarjan_stack.rend() };
-                    state_it != state_it_end; ++state_it) {
-                if (useful[*state_it]) { break; }
-                useful[*state_it] = true;
-            }
-        }
-        final_scc = false;
-        return false;
-    };
-    callback.scc_state_discover = [&](State state) {
-        if(useful[state]) {
-            final_scc = true;
-        }
-    };
-    callback.succ_state_discover = [&](State act_state, State next_state) {
-        if(useful[next_state]) {
-            useful[act_state] = true;
-        }
-    };
-
-    tarjan_scc_discover(callback);
-    return useful;
+const mata::utils::Condensation<State>& Nfa::get_condensation() const {
+    return get_cached(&CachedData::condensation, [&]() {
+        return mata::utils::compute_condensation(
+            num_of_states(), initial, [this](const State state) { return delta[state].moves(); },
+            [](const Move& move) { return move.target; });
+    });
 }
 
 bool Nfa::is_lang_empty_scc() const {
-    bool accepting_state = false;
-
-    TarjanDiscoverCallback callback {};
-    callback.state_discover = [&](State state) -> bool {
-        if(this->final.contains(state)) {
-            accepting_state = true;
-            return true;
-        }
-        return false;
-    };
-
-    tarjan_scc_discover(callback);
-    return !accepting_state;
+    // Stop at the first discovered final state.
+    struct Visitor : mata::utils::SccVisitor<State> {
+        const mata::utils::SparseSet<State>& final;
+        explicit Visitor(const mata::utils::SparseSet<State>& final) : final{ final } {}
+        bool discover_vertex(const State state) const { return final.contains(state); }
+    } visitor{ final };
+    return !tarjan_scc_discover(visitor);
 }
 
 bool Nfa::is_acyclic() const {
-    bool acyclic = true;
-
-    TarjanDiscoverCallback callback {};
-    callback.scc_discover = [&](const std::vector<State>& scc, const std::vector<State>& tarjan_stack) -> bool {
-        (void)tarjan_stack;
-        if(scc.size() > 1) {
-            acyclic = false;
-                return true;
-            } else { // check for self-loops
-                State st = scc[0];
-                for(const auto& sp : this->delta[st]) {
-                    if(sp.targets.find(st) != sp.targets.end()) {
-                        acyclic = false;
-                        return true;
-                    }
-                }
-            }
-            return false;
-    };
-
-    tarjan_scc_discover(callback);
-    return acyclic;
+    // Stop at the first SCC with more than one state or with a self-loop.
+    struct Visitor : mata::utils::SccVisitor<State> {
+        const Delta& delta;
+        explicit Visitor(const Delta& delta) : delta{ delta } {}
+        bool finish_scc(const std::span<const State> scc) const {
+            if (scc.size() > 1) { return true; }
+            return std::any_of(delta[scc[0]].begin(), delta[scc[0]].end(), [&](const SymbolPost& symbol_post) {
+                return symbol_post.targets.contains(scc[0]);
+            });
+        }
+    } visitor{ delta };
+    return !tarjan_scc_discover(visitor);
 }
 
 bool Nfa::is_flat() const {
-    bool flat = true;
-
-    mata::nfa::Nfa::TarjanDiscoverCallback callback {};
-    callback.scc_discover = [&](const std::vector<mata::nfa::State>& scc, const std::vector<mata::nfa::State>& tarjan_stack) -> bool {
-        (void)tarjan_stack;
-        
-        for(const mata::nfa::State& st : scc) {
-            bool one_input_visited = false;
-            for (const mata::nfa::SymbolPost& sp : this->delta[st]) {
-                for (const mata::nfa::State& tgt : scc) {
-                    if(sp.targets.contains(tgt)) {
-                        if(one_input_visited) {
-                            flat = false;
-                            return true;
+    // Stop at the first state with more than one transition within its SCC.
+    struct Visitor : mata::utils::SccVisitor<State> {
+        const Delta& delta;
+        explicit Visitor(const Delta& delta) : delta{ delta } {}
+        bool finish_scc(const std::span<const State> scc) const {
+            for (const State state: scc) {
+                bool one_input_visited{ false };
+                for (const SymbolPost& symbol_post: delta[state]) {
+                    for (const State target: scc) {
+                        if (symbol_post.targets.contains(target)) {
+                            if (one_input_visited) { return true; }
+                            one_input_visited = true;
                         }
-                        one_input_visited = true;
                     }
                 }
             }
+            return false;
         }
-        return false;
-    };
-
-    tarjan_scc_discover(callback);
-    return flat;
+    } visitor{ delta };
+    return !tarjan_scc_discover(visitor);
 }
 
 std::string Nfa::print_to_dot() const {
@@ -489,20 +433,136 @@ void Nfa::get_one_letter_aut(Nfa& result) const {
 }
 
 StateSet Nfa::post(const StateSet& states, const Symbol& symbol) const {
-    StateSet res{};
-    if (delta.empty()) {
-        return res;
+    if (delta.empty()) { return {}; }
+    return EpsilonClosures{ *this }.post(states, symbol);
+}
+
+bool EpsilonClosures::has_epsilon(const State state) const {
+    const StatePost& post{ aut_.delta[state] };
+    return !post.empty() && post.back().symbol >= first_epsilon_;
+}
+
+void EpsilonClosures::append_closure(const State state, std::vector<State>& result) {
+    if (!has_epsilon(state)) {
+        result.push_back(state);
+        return;
+    }
+    const size_t num_of_states{ aut_.num_of_states() };
+    if (ranges_.empty()) {
+        ranges_.resize(num_of_states, { 0, 0 });
+        visited_.resize(num_of_states, 0);
     }
 
+    if (ranges_[state].first == ranges_[state].second) {
+        // Search the epsilon transitions, reusing the closures computed so far.
+        const size_t search{ ++num_of_searches_ };
+        collected_.clear();
+        worklist_.assign(1, state);
+        visited_[state] = search;
+        while (!worklist_.empty()) {
+            const State current{ worklist_.back() };
+            worklist_.pop_back();
+            if (current != state && ranges_[current].first != ranges_[current].second) {
+                collected_.insert(collected_.end(), states_.begin() + static_cast<long>(ranges_[current].first),
+                                  states_.begin() + static_cast<long>(ranges_[current].second));
+                continue;
+            }
+            collected_.push_back(current);
+            const StatePost& post{ aut_.delta[current] };
+            for (auto symbol_post_it{ post.first_epsilon_it(first_epsilon_) }; symbol_post_it != post.end();
+                 ++symbol_post_it) {
+                for (const State target: symbol_post_it->targets) {
+                    if (visited_[target] != search) {
+                        visited_[target] = search;
+                        worklist_.push_back(target);
+                    }
+                }
+            }
+        }
+        std::sort(collected_.begin(), collected_.end());
+        collected_.erase(std::unique(collected_.begin(), collected_.end()), collected_.end());
+        ranges_[state] = { states_.size(), states_.size() + collected_.size() };
+        states_.insert(states_.end(), collected_.begin(), collected_.end());
+    }
+    result.insert(result.end(), states_.begin() + static_cast<long>(ranges_[state].first),
+                  states_.begin() + static_cast<long>(ranges_[state].second));
+}
+
+StateSet EpsilonClosures::close(const std::vector<State>& states) {
+    std::vector<State> closed{};
+    for (const State state: states) { append_closure(state, closed); }
+    return StateSet{ closed };
+}
+
+StateSet EpsilonClosures::closure(const StateSet& states) {
+    return close(std::vector<State>{ states.begin(), states.end() });
+}
+
+StateSet EpsilonClosures::post(const StateSet& states, const Symbol symbol) {
+    std::vector<State> targets{};
     for (const State state: states) {
-        const StatePost& post{ delta[state] };
-        // TODO: This does not handle epsilons.
+        const StatePost& post{ aut_.delta[state] };
         const auto move_it{ post.find(symbol) };
-        if (move_it != post.end()) {
-            res.insert(move_it->targets);
-        }
+        if (move_it != post.end()) { targets.insert(targets.end(), move_it->targets.begin(), move_it->targets.end()); }
     }
-    return res;
+    return close(targets);
+}
+
+bool EpsilonClosures::is_in_lang(const Word& word) {
+    StateSet current_post{ closure(StateSet{ aut_.initial }) };
+    for (const Symbol symbol: word) {
+        current_post = post(current_post, symbol);
+        if (current_post.empty()) { return false; }
+    }
+    return aut_.final.intersects_with(current_post);
+}
+
+bool EpsilonClosures::is_prfx_in_lang(const Word& word) {
+    StateSet current_post{ closure(StateSet{ aut_.initial }) };
+    for (const Symbol symbol: word) {
+        if (aut_.final.intersects_with(current_post)) { return true; }
+        current_post = post(current_post, symbol);
+        if (current_post.empty()) { return false; }
+    }
+    return aut_.final.intersects_with(current_post);
+}
+
+void Traversal::start(const size_t num_of_states) {
+    if (stamps_.size() < num_of_states) {
+        stamps_.resize(num_of_states, 0);
+        parents_.resize(num_of_states);
+        parent_symbols_.resize(num_of_states);
+        depths_.resize(num_of_states);
+    }
+    ++stamp_;
+    discovered_.clear();
+    queue_head_ = 0;
+    stack_.clear();
+}
+
+std::vector<State> Traversal::path_to(State state) const {
+    std::vector<State> path(depths_[state] + 1);
+    for (auto path_it{ path.rbegin() }; path_it != path.rend(); ++path_it) {
+        *path_it = state;
+        state = parents_[state];
+    }
+    return path;
+}
+
+Word Traversal::word_to(State state) const {
+    Word word{};
+    for (; parents_[state] != NO_PARENT; state = parents_[state]) {
+        if (parent_symbols_[state] < first_epsilon_) { word.push_back(parent_symbols_[state]); }
+    }
+    std::reverse(word.begin(), word.end());
+    return word;
+}
+
+Word Traversal::symbols_to(State state) const {
+    Word symbols{};
+    for (; parents_[state] != NO_PARENT; state = parents_[state]) { symbols.push_back(parent_symbols_[state]); }
+    std::reverse(symbols.begin(), symbols.end());
+    return symbols;
 }
 
  void Nfa::unify_initial() {
@@ -542,6 +602,7 @@ Nfa& Nfa::operator=(Nfa&& other) noexcept {
         final = std::move(other.final);
         alphabet = other.alphabet;
         attributes = std::move(other.attributes);
+        cache_ = std::move(other.cache_);
         other.alphabet = nullptr;
     }
     return *this;
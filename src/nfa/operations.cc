@@ -2,16 +2,25 @@
  */
 
 #include <algorithm>
+#include <deque>
 #include <list>
 #include <unordered_set>
 #include <iterator>
+#include <numeric>
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include <ranges>
 
 // MATA headers
 #include "mata/nfa/delta.hh"
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/parallel.hh"
+#include "mata/utils/set-trie.hh"
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
 #include "mata/nfa/builder.hh"
+#include "mata/context.hh"
 #include <mata/simlib/explicit_lts.hh>
 
 using std::tie;
@@ -23,7 +32,10 @@ using mata::Symbol;
 using StateBoolArray = std::vector<bool>; ///< Bool array for states in the automaton.
 
 namespace {
-    Simlib::Util::BinaryRelation compute_fw_direct_simulation(const Nfa& aut) {
+    /**
+     * Build the LTS on which forward direct simulation of @p aut is computed.
+     */
+    Simlib::ExplicitLTS build_lts_for_fw_direct_simulation(const Nfa& aut) {
         OrdVector<mata::Symbol> used_symbols = aut.delta.get_used_symbols();
         mata::Symbol unused_symbol = 0;
         if (!used_symbols.empty() && *used_symbols.begin() == 0) {
@@ -53,20 +65,158 @@ namespace {
         }
 
         lts_for_simulation.init();
-        return lts_for_simulation.compute_simulation();
+        return lts_for_simulation;
     }
 
-    Nfa reduce_size_by_simulation(const Nfa& aut, StateRenaming &state_renaming) {
-        Nfa result;
-        const auto sim_relation = algorithms::compute_relation(
-                aut, ParameterMap{{ "relation", "simulation"}, { "direction", "forward"}});
+    Simlib::Util::BinaryRelation compute_fw_direct_simulation(const Nfa& aut) {
+        return build_lts_for_fw_direct_simulation(aut).compute_simulation();
+    }
+
+    Simlib::Util::PartitionRelation compute_fw_direct_simulation_partition(const Nfa& aut) {
+        return build_lts_for_fw_direct_simulation(aut).compute_simulation_partition();
+    }
+
+    /// Symbols of the transitions from a state paired with the blocks of their targets, sorted.
+    using SimulationSignature = std::vector<std::pair<Symbol, size_t>>;
+
+    /**
+     * Check whether every move in @p smaller can be matched by a move over the same symbol in @p bigger to a block
+     *  related by @p relation.
+     */
+    bool signature_is_covered(const SimulationSignature& smaller, const SimulationSignature& bigger,
+                              const Simlib::Util::PartitionRelation& relation) {
+        auto bigger_it{ bigger.begin() };
+        const auto bigger_end{ bigger.end() };
+        for (auto smaller_it{ smaller.begin() }; smaller_it != smaller.end(); ++smaller_it) {
+            const Symbol symbol{ smaller_it->first };
+            while (bigger_it != bigger_end && bigger_it->first < symbol) { ++bigger_it; }
+            if (bigger_it == bigger_end || bigger_it->first != symbol) { return false; }
+            const std::vector<size_t>& images{ relation.images(smaller_it->second) };
+            bool covered{ false };
+            for (auto it{ bigger_it }; !covered && it != bigger_end && it->first == symbol; ++it) {
+                covered = std::binary_search(images.begin(), images.end(), it->second);
+            }
+            if (!covered) { return false; }
+        }
+        return true;
+    }
+
+    /**
+     * Compute forward direct simulation by a fixpoint refinement of a partition-relation pair, distributing the work
+     *  of each round over @p num_of_threads threads.
+     *
+     * Each round computes for every state its signature (pairs of symbols and blocks of targets), splits the blocks
+     *  by the signatures and relates the new blocks whose old blocks are related and whose signatures cover each
+     *  other. The rounds stop when the relation does not change. The result is the same maximal simulation as
+     *  computed by Simlib.
+     *
+     * A block is stable if neither the block nor the set of states it is related to changed in the last round. The
+     *  signatures of states with only stable successor blocks are not compared again, since the comparison from the
+     *  last round still holds for them.
+     */
+    Simlib::Util::PartitionRelation compute_fw_direct_simulation_parallel(const Nfa& aut, const size_t num_of_threads) {
+        const size_t num_of_states{ aut.num_of_states() };
+        if (num_of_states == 0) { return Simlib::Util::PartitionRelation{}; }
+
+        // Final states can be simulated only by final states.
+        std::vector<size_t> block_of(num_of_states);
+        for (State state{ 0 }; state < num_of_states; ++state) { block_of[state] = aut.final.contains(state) ? 1 : 0; }
+        Simlib::Util::PartitionRelation relation{ block_of, { { 0, 1 }, { 1 } } };
+
+        // Sizes of blocks and of the sets of states the blocks are related to.
+        auto block_sizes = [&](const Simlib::Util::PartitionRelation& rel) {
+            std::vector<std::pair<size_t, size_t>> sizes(rel.blocks(), { 0, 0 });
+            for (State state{ 0 }; state < num_of_states; ++state) { ++sizes[rel.block_of(state)].first; }
+            for (size_t block{ 0 }; block < rel.blocks(); ++block) {
+                for (const size_t image: rel.images(block)) { sizes[block].second += sizes[image].first; }
+            }
+            return sizes;
+        };
+        mata::BoolVector stable(relation.blocks(), false);
+
+        std::vector<SimulationSignature> signatures(num_of_states);
+        std::vector<State> sorted_states(num_of_states);
+        while (true) {
+            parallel_for(num_of_states, num_of_threads, [&](const size_t state, size_t) {
+                SimulationSignature& signature{ signatures[state] };
+                signature.clear();
+                for (const SymbolPost& symbol_post: aut.delta[state]) {
+                    for (const State target: symbol_post.targets) {
+                        signature.emplace_back(symbol_post.symbol, relation.block_of(target));
+                    }
+                }
+                std::sort(signature.begin(), signature.end());
+                signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+            });
+
+            // Split the blocks by signatures. New blocks of the same old block are consecutive.
+            std::iota(sorted_states.begin(), sorted_states.end(), 0);
+            std::sort(sorted_states.begin(), sorted_states.end(), [&](const State lhs, const State rhs) {
+                const size_t lhs_block{ relation.block_of(lhs) };
+                const size_t rhs_block{ relation.block_of(rhs) };
+                if (lhs_block != rhs_block) { return lhs_block < rhs_block; }
+                if (signatures[lhs] != signatures[rhs]) { return signatures[lhs] < signatures[rhs]; }
+                return lhs < rhs;
+            });
+            std::vector<State> new_block_representatives{};
+            std::vector<size_t> first_new_block_of_block(relation.blocks() + 1, 0);
+            for (const State state: sorted_states) {
+                if (new_block_representatives.empty()
+                    || relation.block_of(new_block_representatives.back()) != relation.block_of(state)
+                    || signatures[new_block_representatives.back()] != signatures[state]) {
+                    new_block_representatives.push_back(state);
+                    first_new_block_of_block[relation.block_of(state) + 1] = new_block_representatives.size();
+                }
+                block_of[state] = new_block_representatives.size() - 1;
+            }
+
+            const size_t num_of_new_blocks{ new_block_representatives.size() };
+            std::vector<std::vector<size_t>> images(num_of_new_blocks);
+            parallel_for(num_of_new_blocks, num_of_threads, [&](const size_t new_block, size_t) {
+                const State representative{ new_block_representatives[new_block] };
+                const SimulationSignature& signature{ signatures[representative] };
+                const bool successors_stable{ std::all_of(signature.begin(), signature.end(), [&](const auto& move) {
+                    return stable[move.second];
+                }) };
+                for (const size_t related_block: relation.images(relation.block_of(representative))) {
+                    for (size_t other{ first_new_block_of_block[related_block] };
+                         other < first_new_block_of_block[related_block + 1]; ++other) {
+                        if (successors_stable || signature_is_covered(
+                                signature, signatures[new_block_representatives[other]], relation)) {
+                            images[new_block].push_back(other);
+                        }
+                    }
+                }
+            });
+
+            Simlib::Util::PartitionRelation refined{ block_of, images };
+            // The refined relation is included in the previous one, hence they are equal when they have the same
+            //  number of blocks and of related pairs of blocks.
+            if (refined.blocks() == relation.blocks() && refined.block_pairs() == relation.block_pairs()) {
+                return refined;
+            }
+            // Blocks and their upward closures only shrink, so equal sizes mean equal sets.
+            const std::vector<std::pair<size_t, size_t>> old_sizes{ block_sizes(relation) };
+            const std::vector<std::pair<size_t, size_t>> new_sizes{ block_sizes(refined) };
+            stable.assign(refined.blocks(), false);
+            for (size_t block{ 0 }; block < refined.blocks(); ++block) {
+                stable[block] = new_sizes[block] == old_sizes[relation.block_of(refined.head(block))];
+            }
+            relation = std::move(refined);
+        }
+    }
 
-        auto sim_relation_symmetric = sim_relation;
-        sim_relation_symmetric.restrict_to_symmetric();
+    Nfa reduce_size_by_simulation(const Nfa& aut, StateRenaming &state_renaming, const ParameterMap& params) {
+        Nfa result;
+        ParameterMap relation_params{{ "relation", "simulation"}, { "direction", "forward"}};
+        if (haskey(params, "threads")) { relation_params["threads"] = params.at("threads"); }
+        // The simulation is kept as a partition into simulation-equivalence classes with a relation on the classes,
+        //  so that no (quadratic) matrix over all states needs to be built.
+        const auto sim_relation = algorithms::compute_partition_relation(aut, relation_params);
 
         // for State q, quot_proj[q] should be the representative state representing the symmetric class of states in simulation
         std::vector<size_t> quot_proj;
-        sim_relation_symmetric.get_quotient_projection(quot_proj);
+        sim_relation.get_quotient_projection(quot_proj);
 
         const size_t num_of_states = aut.num_of_states();
 
@@ -117,6 +267,7 @@ namespace {
                     // add the transition 'q_class_state-q_trans.symbol->representatives_class_states' at the end of transition list of transitions starting from q_class_state
                     // as the q_trans.symbol should be the largest symbol we saw (as we iterate trough getTransitionsFromState(q) which is ordered)
                     result.delta.mutable_state_post(q_class_state).insert(SymbolPost(q_trans.symbol, representatives_class_states));
+                    result.delta.release_mutable_references();
                 }
 
                 if (aut.final[q]) { // if q is final, then all states in its class are final => we make q_class_state final
@@ -159,64 +310,82 @@ namespace {
         }
     }
 
-    void check_covered_and_covering(std::vector<StateSet>& covering_states,                 // covering sets for each state
-                                    std::vector<StateSet>& covering_indexes,                // indexes of covering states
-                                    std::unordered_map<StateSet, State>& covered,           // map of covered states
-                                    std::unordered_map<StateSet, State>& subset_map,        // map of non-covered states
-                                    const State Tid, const StateSet& T,                      // current state to check
-                                    Nfa& result) {
-
-        auto it = subset_map.begin();
+    /// Macrostates of the residual automaton under construction, indexed by the states of the result.
+    struct ResidualMacrostates {
+        std::vector<StateSet> macrostates{};                // macrostate of each state
+        SetTrie<State, State> non_covered{};                // index of non-covered macrostates
+        SetTrie<State, State> covered{};                    // index of covered macrostates
+        mata::BoolVector is_covered{};                      // flags of covered states
+        std::vector<StateSet> covering_states{};            // covering sets for each state
+        std::vector<StateSet> covering_indexes{};           // indexes of covering states
+        std::vector<std::vector<State>> covering_users{};   // states whose covering indexes may contain the state
+
+        void push_back(const StateSet& macrostate) {
+            macrostates.push_back(macrostate);
+            is_covered.push_back(false);
+            covering_states.emplace_back();
+            covering_indexes.emplace_back();
+            covering_users.emplace_back();
+        }
 
-        // initiate with empty StateSets
-        covering_states.emplace_back();
-        covering_indexes.emplace_back();
+        void add_covering_indexes(const State state, const StateSet& indexes) {
+            covering_indexes[state].insert(indexes);
+            for (const State index: indexes) { covering_users[index].push_back(state); }
+        }
+    };
 
-        while (it != subset_map.end()) {               // goes through all found states
-            if (it->first.is_subset_of(T)) {
-                // check if T is covered
-                // if so add covering state to its covering StateSet
+    void check_covered_and_covering(ResidualMacrostates& data,
+                                    const State Tid, const StateSet& T,                      // current state to check
+                                    Nfa& result) {
+        data.push_back(T);
+
+        // check if T is covered
+        // if so add covering state to its covering StateSet
+        data.non_covered.for_each_subset_of(T, [&](const State covering) {
+            data.covering_states[Tid].insert(data.macrostates[covering]);
+            data.add_covering_indexes(Tid, { covering });
+        });
+
+        // check if states in map are covered
+        // if so add covering state to its covering StateSet
+        std::vector<State> supersets;
+        data.non_covered.for_each_superset_of(T, [&](const State superset) { supersets.push_back(superset); });
+        std::sort(supersets.begin(), supersets.end());
+        for (const State superset: supersets) {
+            data.covering_states[superset].insert(T);
+            data.add_covering_indexes(superset, { Tid });
+
+            // check is some already existing state that had a new covering state added turned fully covered
+            if (data.macrostates[superset] == data.covering_states[superset]) {
+                // if any covered state is in the covering set of newly turned covered state,
+                // then it has to be replaced by its covering set
+                const State erase_state = superset;      // covered state to remove
+                StateSet covered_covering;
+                for (const State covering: data.covering_indexes[erase_state]) {
+                    if (data.is_covered[covering]) { covered_covering.insert(covering); }
+                }
+                for (const State covering: covered_covering) {
+                    data.covering_indexes[erase_state].erase(covering);
+                    data.add_covering_indexes(erase_state, data.covering_indexes[covering]);
+                }
 
-                covering_states[Tid].insert(it->first);
-                covering_indexes[Tid].insert(it->second);
-            }
-            else if (T.is_subset_of(it->first)) {
-                // check if state in map is covered
-                // if so add covering state to its covering StateSet
-
-                covering_states[it->second].insert(T);
-                covering_indexes[it->second].insert(Tid);
-
-                // check is some already existing state that had a new covering state added turned fully covered
-                if (it->first == covering_states[it->second]) {
-                    // if any covered state is in the covering set of newly turned covered state,
-                    // then it has to be replaced by its covering set
-                    //
-                    // same applies for any covered state, if it contains newly turned state in theirs
-                    // covering set, then it has to be updated
-                    State erase_state = it->second;      // covered state to remove
-                    for (const auto& covered_pair: covered) {
-                        if (covering_indexes[covered_pair.second].contains(erase_state)) {
-                            covering_indexes[covered_pair.second].erase(erase_state);
-                            covering_indexes[covered_pair.second].insert(covering_indexes[erase_state]);
-                        }
-                        if (covering_indexes[erase_state].contains(covered_pair.second)) {
-                            covering_indexes[erase_state].erase(covered_pair.second);
-                            covering_indexes[erase_state].insert(covering_indexes[covered_pair.second]);
-                        }
+                // same applies for any covered state, if it contains newly turned state in theirs
+                // covering set, then it has to be updated
+                for (const State user: data.covering_users[erase_state]) {
+                    if (data.is_covered[user] && data.covering_indexes[user].contains(erase_state)) {
+                        data.covering_indexes[user].erase(erase_state);
+                        data.add_covering_indexes(user, data.covering_indexes[erase_state]);
                     }
+                }
 
-                    // remove covered state from the automaton, replace with covering set
-                    remove_covered_state(covering_indexes[erase_state], erase_state, result);
+                // remove covered state from the automaton, replace with covering set
+                remove_covered_state(data.covering_indexes[erase_state], erase_state, result);
 
-                    auto temp = it++;
-                    // move state from subset_map to covered
-                    auto transfer = subset_map.extract(temp);
-                    covered.insert(std::move(transfer));
-                    continue;           // skip increasing map pointer
-                }
+                // move state from non-covered to covered
+                data.non_covered.erase(data.macrostates[erase_state]);
+                data.covered.insert(data.macrostates[erase_state], erase_state);
+                data.is_covered[erase_state] = true;
             }
-            ++it;
         }
     }
 
@@ -226,11 +395,8 @@ namespace {
 
         //assuming all sets targets are non-empty
         std::vector<std::pair<State, StateSet>> worklist;
-        std::unordered_map<StateSet, State> subset_map;
-
-        std::vector<StateSet> covering_states;          // check covering set
-        std::vector<StateSet> covering_indexes;         // indexes of covering macrostates
-        std::unordered_map<StateSet, State> covered;    // map of covered states for transfering new transitions
+        // Macrostates with subset/superset indexes of non-covered and covered macrostates for finding covering sets.
+        ResidualMacrostates data;
 
         result.clear();
         const StateSet S0 =  StateSet(aut.initial);
@@ -242,9 +408,8 @@ namespace {
         }
         worklist.emplace_back(S0id, S0);
 
-        (subset_map)[mata::utils::OrdVector<State>(S0)] = S0id;
-        covering_states.emplace_back();
-        covering_indexes.emplace_back();
+        data.push_back(S0);
+        data.non_covered.insert(S0, S0id);
 
         if (aut.delta.empty()){
             return result;
@@ -277,20 +442,20 @@ namespace {
                 Symbol currentSymbol = (*moves.begin())->symbol;
                 StateSet T = synchronized_iterator.unify_targets(); // new state unify
 
-                auto existingTitr = subset_map.find(T);        // check if state was alredy discovered
+                const State* existing_id;
                 State Tid;
-                if (existingTitr != subset_map.end()) {        // already visited state
-                    Tid = existingTitr->second;
+                if ((existing_id = data.non_covered.find(T)) != nullptr) {        // already visited state
+                    Tid = *existing_id;
                     add = true;
                 }
-                else if ((existingTitr = covered.find(T)) != covered.end()) {
-                    Tid = existingTitr->second;
+                else if ((existing_id = data.covered.find(T)) != nullptr) {
+                    Tid = *existing_id;
                 } else {                                        // add new state
                     Tid = result.add_state();
-                    check_covered_and_covering(covering_states, covering_indexes, covered, subset_map, Tid, T, result);
+                    check_covered_and_covering(data, Tid, T, result);
 
-                    if (T != covering_states[Tid]){     // new state is not covered, replace transitions
-                        subset_map[mata::utils::OrdVector<State>(T)] = Tid;      // add to map
+                    if (T != data.covering_states[Tid]){     // new state is not covered, replace transitions
+                        data.non_covered.insert(T, Tid);      // add to map
 
                         if (aut.final.intersects_with(T))                      // add to final
                             result.final.insert(Tid);
@@ -299,18 +464,20 @@ namespace {
                         add  = true;
 
                     } else {            // new state is covered
-                        covered[mata::utils::OrdVector<State>(T)] = Tid;
+                        data.covered.insert(T, Tid);
+                        data.is_covered[Tid] = true;
                     }
                 }
 
-                if (covered.find(S) != covered.end()) {
+                if (data.is_covered[Sid]) {
                     continue;           // skip generationg any transitions as the source state was covered right now
                 }
 
                 if (add) {
                     result.delta.mutable_state_post(Sid).insert(SymbolPost(currentSymbol, Tid));
+                    result.delta.release_mutable_references();
                 } else {
-                    for (State switch_target: covering_indexes[Tid]){
+                    for (State switch_target: data.covering_indexes[Tid]){
                             result.delta.add(Sid, currentSymbol, switch_target);
                     }
                 }
@@ -382,9 +549,17 @@ namespace {
 
         std::vector <StateSet> macrostate_vec;              // ordered vector of macrostates
         macrostate_vec.reserve(subset_map.size());
-        for (const auto& pair: subset_map) {                   // order by size from largest to smallest
-            macrostate_vec.insert(std::upper_bound(macrostate_vec.begin(), macrostate_vec.end(), pair.first,
-                                [](const StateSet & a, const StateSet & b){ return a.size() > b.size(); }), pair.first);
+        for (const auto& pair: subset_map) {
+            macrostate_vec.push_back(pair.first);
+        }
+        // order by size from largest to smallest
+        std::stable_sort(macrostate_vec.begin(), macrostate_vec.end(),
+                         [](const StateSet & a, const StateSet & b){ return a.size() > b.size(); });
+
+        // index of macrostate_vec for finding covering macrostates
+        SetTrie<State, size_t> macrostate_index;
+        for (size_t i = 0; i < macrostate_vec.size(); ++i) {
+            macrostate_index.insert(macrostate_vec[i], i);
         }
 
         std::vector <bool> covered(subset_map.size(), false);          // flag of covered states, removed from nfa
@@ -404,14 +579,15 @@ namespace {
             covering_indexes.clear();
             visited[i] = true;
 
-            for (size_t j = i+1; j < macrostate_size; j++) {        // find covering macrostates
-                if (covered[j])     // if covered there are smaller macrostates, skip
-                    continue;
-
-                if (macrostate_vec[j].is_subset_of(macrostate_vec[i])) {           // found covering state
-                    covering_set.insert(macrostate_vec[j]);               // is not covered
+            // find covering macrostates, all proper subsets are after i as macrostate_vec is ordered by size
+            macrostate_index.for_each_subset_of(macrostate_vec[i], [&](const size_t j) {
+                if (j != i && !covered[j]) {     // if covered there are smaller macrostates, skip
                     covering_indexes.push_back(j);
                 }
+            });
+            std::sort(covering_indexes.begin(), covering_indexes.end());
+            for (const size_t j: covering_indexes) {      // found covering state
+                covering_set.insert(macrostate_vec[j]);    // is not covered
             }
 
             if (covering_set == macrostate_vec[i]) {
@@ -448,7 +624,7 @@ namespace {
     }
 
     Nfa reduce_size_by_residual(const Nfa& aut, StateRenaming &state_renaming, const std::string& type, const std::string& direction){
-        Nfa back_determinized = aut;
+        Nfa back_determinized;
         Nfa result;
 
         if (direction != "forward" && direction != "backward"){
@@ -460,9 +636,11 @@ namespace {
         // then the residual construction is done forward, for backward residual automaton
         // is it the opposite, so the automaton is reverted once more before and after
         // construction, however the first two reversion negate each other out
-        if (direction == "forward")
-            back_determinized = revert(back_determinized);
-        back_determinized = revert(determinize(back_determinized));          // backward deteminization
+        if (direction == "forward") {
+            back_determinized = determinize_backward(aut);                    // backward deteminization
+        } else {
+            back_determinized = revert(determinize(aut));
+        }
 
         // not relly sure how to handle state_renaming
         (void) state_renaming;
@@ -527,251 +705,202 @@ bool mata::nfa::Nfa::make_complete(const OrdVector<Symbol>& symbols, const std::
     return transition_added;
 }
 
-//TODO: based on the comments inside, this function needs to be rewritten in a more optimal way.
-Nfa mata::nfa::remove_epsilon(const Nfa& aut, Symbol epsilon) {
-    // cannot use multimap, because it can contain multiple occurrences of (a -> a), (a -> a)
-    std::unordered_map<State, StateSet> eps_closure;
-
-    // TODO: grossly inefficient
-    // first we compute the epsilon closure
-    const size_t num_of_states{aut.num_of_states() };
-    for (size_t i{ 0 }; i < num_of_states; ++i)
-    {
-        for (const auto& trans: aut.delta[i])
-        { // initialize
-            const auto it_ins_pair = eps_closure.insert({i, {i}});
-            if (trans.symbol == epsilon)
-            {
-                StateSet& closure = it_ins_pair.first->second;
-                // TODO: Fix possibly insert to OrdVector. Create list already ordered, then merge (do not need to resize each time);
-                closure.insert(trans.targets);
-            }
-        }
-    }
-
-    bool changed = true;
-    while (changed) { // Compute the fixpoint.
-        changed = false;
-        for (size_t i = 0; i < num_of_states; ++i) {
-            const StatePost& post{ aut.delta[i] };
-            const auto eps_move_it { post.find(epsilon) };//TODO: make faster if default epsilon
-            if (eps_move_it != post.end()) {
-                StateSet& src_eps_cl = eps_closure[i];
-                for (const State tgt: eps_move_it->targets) {
-                    const StateSet& tgt_eps_cl = eps_closure[tgt];
-                    for (const State st: tgt_eps_cl) {
-                        if (src_eps_cl.count(st) == 0) {
-                            changed = true;
-                            break;
-                        }
-                    }
-                    src_eps_cl.insert(tgt_eps_cl);
+namespace {
+    /**
+     * Remove transitions over all symbols satisfying @p is_epsilon, all of which are handled as epsilon transitions.
+     *
+     * The epsilon closure is the same for all states of an SCC of the epsilon transitions, and it is the union of the
+     *  SCC with the closures of its successors in the condensation. Those are computed before the SCC in the reverse
+     *  topological order, hence, every closure is computed once, as a single sorted merge.
+     */
+    template<class IsEpsilon>
+    Nfa remove_epsilons(const Nfa& aut, const IsEpsilon& is_epsilon) {
+        const size_t num_of_states{ aut.num_of_states() };
+        // Targets of epsilon transitions of each state. Targets of a single epsilon symbol are taken from the delta,
+        //  targets of several epsilon symbols are merged into 'merged_eps_targets' (which keeps its references valid).
+        std::vector<const StateSet*> eps_targets(num_of_states, nullptr);
+        std::deque<StateSet> merged_eps_targets{};
+        bool has_epsilon{ false };
+        for (State state{ 0 }; state < num_of_states; ++state) {
+            for (const SymbolPost& symbol_post: aut.delta[state]) {
+                if (!is_epsilon(symbol_post.symbol)) { continue; }
+                has_epsilon = true;
+                if (eps_targets[state] == nullptr) {
+                    eps_targets[state] = &symbol_post.targets;
+                    continue;
+                }
+                if (merged_eps_targets.empty() || eps_targets[state] != &merged_eps_targets.back()) {
+                    merged_eps_targets.push_back(*eps_targets[state]);
+                    eps_targets[state] = &merged_eps_targets.back();
                 }
+                merged_eps_targets.back().insert(symbol_post.targets);
             }
         }
-    }
-
-    // Construct the automaton without epsilon transitions.
-    Nfa result{ Delta{}, aut.initial, aut.final, aut.alphabet };
-    for (const auto& state_closure_pair : eps_closure) { // For every state.
-        State src_state = state_closure_pair.first;
-        for (State eps_cl_state : state_closure_pair.second) { // For every state in its epsilon closure.
-            if (aut.final[eps_cl_state]) result.final.insert(src_state);
-            for (const SymbolPost& move : aut.delta[eps_cl_state]) {
-                if (move.symbol == epsilon) continue;
-                // TODO: this could be done more efficiently if we had a better add method
-                for (State tgt_state : move.targets) {
-                    result.delta.add(src_state, move.symbol, tgt_state);
-                }
+        if (!has_epsilon) { return Nfa{ aut.delta, aut.initial, aut.final, aut.alphabet }; }
+
+        const StateSet no_targets{};
+        const mata::utils::Condensation<State> sccs{ mata::utils::compute_condensation(
+            num_of_states, std::views::iota(State{ 0 }, State{ num_of_states }),
+            [&](const State state) -> const StateSet& {
+                return eps_targets[state] == nullptr ? no_targets : *eps_targets[state];
+            }) };
+        const size_t num_of_sccs{ sccs.num_of_sccs() };
+        std::vector<StateSet> closures(num_of_sccs);
+        std::vector<State> closure{};
+        for (size_t scc{ num_of_sccs }; scc-- > 0;) {
+            closure.assign(sccs.scc(scc).begin(), sccs.scc(scc).end());
+            for (const size_t target_scc: sccs.scc_successors(scc)) {
+                closure.insert(closure.end(), closures[target_scc].begin(), closures[target_scc].end());
             }
+            closures[scc] = StateSet{ closure };
         }
-    }
-    return result;
-}
-
-Nfa mata::nfa::fragile_revert(const Nfa& aut) {
-    const size_t num_of_states{ aut.num_of_states() };
-
-    Nfa result(num_of_states);
-
-    result.initial = aut.final;
-    result.final = aut.initial;
-
-    // Compute non-epsilon symbols.
-    OrdVector<Symbol> symbols = aut.delta.get_used_symbols();
-    if (symbols.empty()) { return result; }
-    if (symbols.back() == EPSILON) { symbols.pop_back(); }
-    // size of the "used alphabet", i.e. max symbol+1 or 0
-    Symbol alphasize =  (symbols.empty()) ? 0 : (symbols.back()+1);
-
-#ifdef _STATIC_STRUCTURES_
-    //STATIC DATA STRUCTURES:
-    // Not sure that it works ideally, whether the space for the inner vectors stays there.
-    static std::vector<std::vector<State>> sources;
-    static std::vector<std::vector<State>> targets;
-    static std::vector<State> e_sources;
-    static std::vector<State> e_targets;
-    if (alphasize>sources.size()) {
-        sources.resize(alphasize);
-        targets.resize(alphasize);
-    }
 
-    e_sources.clear();
-    e_targets.clear();
-
-    //WHEN ONLY MAX SYMBOL IS COMPUTED
-    // for (int i = 0;i<alphasize;i++) {
-    //     for (int i = 0;i<alphasize;i++) {
-    //         if (!sources[i].empty())
-    //         {
-    //             sources[i].resize(0);
-    //             targets[i].resize(0);
-    //         }
-    //     }
-    // }
-
-    //WHEN ALL SYMBOLS ARE COMPUTED
-    for (Symbol symbol: symbols) {
-        if(!sources[symbol].empty()) {
-            sources[symbol].clear();
-            targets[symbol].clear();
-        }
-    }
-#else
-    // NORMAL, NON STATIC DATA STRUCTURES:
-    //All transition of delta are to be copied here, into two arrays of transition sources and targets indexed by the transition symbol.
-    // There is a special treatment for epsilon, since we want the arrays to be only as long as the largest symbol in the automaton,
-    // and epsilon is the maximum (so we don't want to have the maximum array lenght whenever epsilon is present)
-    std::vector<std::vector<State>> sources (alphasize);
-    std::vector<std::vector<State>> targets (alphasize);
-    std::vector<State> e_sources;
-    std::vector<State> e_targets;
-#endif
-
-    //Copy all transition with non-e symbols to the arrays of sources and targets indexed by symbols.
-    //Targets and sources of e-transitions go to the special place.
-    //Important: since we are going through delta in order of sources, the sources arrays are all ordered.
-    for (State sourceState{ 0 }; sourceState < num_of_states; ++sourceState) {
-        for (const SymbolPost &move: aut.delta[sourceState]) {
-            if (move.symbol == EPSILON) {
-                for (const State targetState: move.targets) {
-                    //reserve_on_insert(e_sources);
-                    e_sources.push_back(sourceState);
-                    //reserve_on_insert(e_targets);
-                    e_targets.push_back(targetState);
+        // Construct the automaton without epsilon transitions, one whole state post per state. States of an SCC
+        //  share their state post, which is built by merging the non-epsilon symbol posts of the closure.
+        Nfa result{ Delta{}, aut.initial, aut.final, aut.alphabet };
+        std::vector<StatePost> posts(num_of_states);
+        SynchronizedExistentialSymbolPostIterator sync_iterator{};
+        for (size_t scc{ 0 }; scc < num_of_sccs; ++scc) {
+            const StateSet& scc_closure{ closures[scc] };
+            StatePost post{};
+            if (scc_closure.size() == 1) {
+                // A single state, at most with epsilon self-loops.
+                for (const SymbolPost& symbol_post: aut.delta[scc_closure.front()]) {
+                    if (!is_epsilon(symbol_post.symbol)) { post.push_back(symbol_post); }
                 }
-            }
-            else {
-                for (const State targetState: move.targets) {
-                    //reserve_on_insert(sources[move.symbol]);
-                    sources[move.symbol].push_back(sourceState);
-                    //reserve_on_insert(targets[move.symbol]);
-                    targets[move.symbol].push_back(targetState);
+            } else {
+                sync_iterator.reset();
+                for (const State state: scc_closure) { mata::utils::push_back(sync_iterator, aut.delta[state]); }
+                while (sync_iterator.advance()) {
+                    const Symbol symbol{ sync_iterator.get_current()[0]->symbol };
+                    if (is_epsilon(symbol)) { continue; }
+                    post.push_back(SymbolPost{ symbol, sync_iterator.unify_targets() });
                 }
             }
-        }
-    }
-
-    //Now make the delta of the reversed automaton.
-    //Important: since sources are ordered, when adding them as targets, we can just push them back.
-    result.delta.reserve(num_of_states);
 
-    // adding non-e transitions
-    for (const Symbol symbol: symbols) {
-        for (size_t i{ 0 }; i < sources[symbol].size(); ++i) {
-            State tgt_state =sources[symbol][i];
-            State src_state =targets[symbol][i];
-            StatePost & src_post = result.delta.mutable_state_post(src_state);
-            if (src_post.empty() || src_post.back().symbol != symbol) {
-                src_post.push_back(SymbolPost(symbol));
+            const bool is_final{ aut.final.intersects_with(scc_closure) };
+            const std::span<const State> scc_states = sccs.scc(scc);
+            for (size_t i{ 0 }; i < scc_states.size(); ++i) {
+                if (is_final) { result.final.insert(scc_states[i]); }
+                posts[scc_states[i]] = i + 1 < scc_states.size() ? post : std::move(post);
             }
-            src_post.back().push_back(tgt_state);
-        }
-    }
-
-    // adding e-transitions
-    for (size_t i{ 0 }; i < e_sources.size(); ++i) {
-        State tgt_state =e_sources[i];
-        State src_state =e_targets[i];
-        StatePost & src_post = result.delta.mutable_state_post(src_state);
-        if (src_post.empty() || src_post.back().symbol != EPSILON) {
-            src_post.push_back(SymbolPost(EPSILON));
         }
-        src_post.back().push_back(tgt_state);
+        result.delta.reserve(num_of_states);
+        for (StatePost& post: posts) { result.delta.emplace_back(std::move(post)); }
+        result.delta.release_mutable_references();
+        return result;
     }
+}
 
-    //sorting the targets
-    //Hm I don't know why I put this here, but it should not be needed ...
-    //for (State q = 0, states_num = result.delta.post_size(); q<states_num;++q) {
-    //    for (auto m = result.delta.get_mutable_post(q).begin(); m != result.delta.get_mutable_post(q).end(); ++m) {
-    //        sort_and_rmdupl(m->targets);
-    //    }
-    //}
+Nfa mata::nfa::remove_epsilon(const Nfa& aut, const Symbol epsilon) {
+    return remove_epsilons(aut, [epsilon](const Symbol symbol) { return symbol == epsilon; });
+}
 
-    return result;
+Nfa mata::nfa::remove_epsilon(const Nfa& aut, const Symbol first_epsilon, const Symbol last_epsilon) {
+    return remove_epsilons(aut, [first_epsilon, last_epsilon](const Symbol symbol) {
+        return first_epsilon <= symbol && symbol <= last_epsilon;
+    });
 }
 
-Nfa mata::nfa::simple_revert(const Nfa& aut) {
-    Nfa result;
-    result.clear();
+Nfa mata::nfa::remove_epsilon(const Nfa& aut, const OrdVector<Symbol>& epsilons) {
+    return remove_epsilons(aut, [&epsilons](const Symbol symbol) { return epsilons.contains(symbol); });
+}
 
+mata::nfa::PredecessorIndex::PredecessorIndex(const Nfa& aut, const size_t num_of_threads) {
+    // Transitions are sorted into the order of the reverted delta, i.e., by (target, symbol, source), by two passes
+    //  of a counting sort. The first pass sorts by symbols, using compacted ids of the used symbols as keys, and it
+    //  keeps sources ordered as they come from the delta. It runs over chunks of source states in parallel: every
+    //  chunk counts its transitions over each symbol and then writes them at offsets computed from all the counts.
+    //  The second pass sorts by targets.
     const size_t num_of_states{ aut.num_of_states() };
-    result.delta.allocate(num_of_states);
+    begins.assign(num_of_states + 1, 0);
+    const OrdVector<Symbol> used_symbols{ aut.delta.get_used_symbols() };
+    const std::vector<Symbol> used_symbol_vector{ used_symbols.begin(), used_symbols.end() };
+    if (used_symbol_vector.empty()) { return; }
+    const size_t num_of_symbols{ used_symbol_vector.size() };
+    auto symbol_id = [&](const Symbol symbol) {
+        return static_cast<size_t>(std::lower_bound(used_symbol_vector.begin(), used_symbol_vector.end(), symbol)
+                                   - used_symbol_vector.begin());
+    };
 
-    for (State sourceState{ 0 }; sourceState < num_of_states; ++sourceState) {
-        for (const SymbolPost &transition: aut.delta[sourceState]) {
-            for (const State targetState: transition.targets) {
-                result.delta.add(targetState, transition.symbol, sourceState);
+    const size_t num_of_chunks{ std::max(size_t{ 1 }, std::min(num_of_threads, num_of_states)) };
+    auto chunk_begin = [&](const size_t chunk) { return chunk * num_of_states / num_of_chunks; };
+    // 'offsets[chunk * num_of_symbols + id]' is the number of transitions of the chunk over the symbol with 'id', then
+    //  the position of the next such transition in the sorted transitions.
+    std::vector<size_t> offsets(num_of_chunks * num_of_symbols, 0);
+    parallel_for(num_of_chunks, num_of_threads, [&](const size_t chunk, size_t) {
+        size_t* const chunk_counts{ offsets.data() + chunk * num_of_symbols };
+        for (State source{ chunk_begin(chunk) }; source < chunk_begin(chunk + 1); ++source) {
+            for (const SymbolPost& symbol_post: aut.delta[source]) {
+                chunk_counts[symbol_id(symbol_post.symbol)] += symbol_post.num_of_targets();
             }
         }
+    });
+    // Transitions over the symbol with 'id' are at positions from 'symbol_begins[id]' in the sorted transitions.
+    std::vector<size_t> symbol_begins(num_of_symbols + 1);
+    size_t num_of_transitions{ 0 };
+    for (size_t id{ 0 }; id < num_of_symbols; ++id) {
+        symbol_begins[id] = num_of_transitions;
+        for (size_t chunk{ 0 }; chunk < num_of_chunks; ++chunk) {
+            const size_t count{ offsets[chunk * num_of_symbols + id] };
+            offsets[chunk * num_of_symbols + id] = num_of_transitions;
+            num_of_transitions += count;
+        }
     }
-
-    result.initial = aut.final;
-    result.final = aut.initial;
-
-    return result;
-}
-
-//not so great, can be removed
-Nfa mata::nfa::somewhat_simple_revert(const Nfa& aut) {
-    const size_t num_of_states{ aut.num_of_states() };
-
-    Nfa result(num_of_states);
-
-    result.initial = aut.final;
-    result.final = aut.initial;
-
-    for (State sourceState{ 0 }; sourceState < num_of_states; ++sourceState) {
-        for (const SymbolPost &transition: aut.delta[sourceState]) {
-            for (const State targetState: transition.targets) {
-                StatePost & post = result.delta.mutable_state_post(targetState);
-                //auto move = std::find(post.begin(),post.end(),Move(transition.symbol));
-                auto move = post.find(SymbolPost(transition.symbol));
-                if (move == post.end()) {
-                    //post.push_back(Move(transition.symbol,sourceState));
-                    post.insert(SymbolPost(transition.symbol, sourceState));
+    symbol_begins[num_of_symbols] = num_of_transitions;
+
+    std::vector<State> symbol_sorted_sources(num_of_transitions);
+    std::vector<State> symbol_sorted_targets(num_of_transitions);
+    parallel_for(num_of_chunks, num_of_threads, [&](const size_t chunk, size_t) {
+        size_t* const chunk_offsets{ offsets.data() + chunk * num_of_symbols };
+        for (State source{ chunk_begin(chunk) }; source < chunk_begin(chunk + 1); ++source) {
+            for (const SymbolPost& symbol_post: aut.delta[source]) {
+                size_t& offset{ chunk_offsets[symbol_id(symbol_post.symbol)] };
+                for (const State target: symbol_post.targets) {
+                    symbol_sorted_sources[offset] = source;
+                    symbol_sorted_targets[offset] = target;
+                    ++offset;
                 }
-                else
-                    move->push_back(sourceState);
-                    //move->insert(sourceState);
             }
         }
+    });
+
+    // The second pass.
+    for (const State target: symbol_sorted_targets) { ++begins[target + 1]; }
+    std::partial_sum(begins.begin(), begins.end(), begins.begin());
+    sources.resize(num_of_transitions);
+    symbols.resize(num_of_transitions);
+    std::vector<size_t> next{ begins.begin(), begins.end() - 1 };
+    for (size_t id{ 0 }; id < num_of_symbols; ++id) {
+        for (size_t i{ symbol_begins[id] }; i < symbol_begins[id + 1]; ++i) {
+            const size_t position{ next[symbol_sorted_targets[i]]++ };
+            sources[position] = symbol_sorted_sources[i];
+            symbols[position] = used_symbol_vector[id];
+        }
     }
-
-    //sorting the targets
-    for (State q = 0, states_num = result.delta.num_of_states(); q < states_num; ++q) {
-        //Post & post = result.delta.get_mutable_post(q);
-        //utils::sort_and_rmdupl(post);
-        for (SymbolPost& m: result.delta.mutable_state_post(q)) { sort_and_rmdupl(m.targets); }
-    }
-
-    return result;
 }
 
-Nfa mata::nfa::revert(const Nfa& aut) {
-    return simple_revert(aut);
-    //return fragile_revert(aut);
-    //return somewhat_simple_revert(aut);
+Nfa mata::nfa::revert(const Nfa& aut, const size_t num_of_threads) {
+    // The state posts of the reverted delta are read off the index of predecessors directly.
+    const size_t num_of_states{ aut.num_of_states() };
+    const PredecessorIndex predecessors{ aut, num_of_threads };
+    Nfa result{ Delta{}, aut.final, aut.initial };
+    std::vector<StatePost> posts(num_of_states);
+    parallel_for(num_of_states, num_of_threads, [&](const State state, size_t) {
+        StatePost& post{ posts[state] };
+        for (size_t i{ predecessors.begins[state] }; i < predecessors.begins[state + 1];) {
+            const Symbol symbol{ predecessors.symbols[i] };
+            size_t end{ i };
+            while (end < predecessors.begins[state + 1] && predecessors.symbols[end] == symbol) { ++end; }
+            StateSet post_targets{ StateSet::with_reserved(end - i) };
+            for (; i < end; ++i) { post_targets.push_back(predecessors.sources[i]); }
+            post.push_back(SymbolPost{ symbol, std::move(post_targets) });
+        }
+    });
+    result.delta.reserve(num_of_states);
+    for (StatePost& post: posts) { result.delta.emplace_back(std::move(post)); }
+    result.delta.release_mutable_references();
+    return result;
 }
 
 bool mata::nfa::Nfa::is_deterministic() const {
@@ -789,38 +918,18 @@ bool mata::nfa::Nfa::is_deterministic() const {
     return true;
 }
 bool mata::nfa::Nfa::is_complete(Alphabet const* alphabet) const {
-    utils::OrdVector<Symbol> symbols{ get_symbols_to_work_with(*this, alphabet) };
-    utils::OrdVector<Symbol> symbs_ls{ symbols };
-
-    // TODO: make a general function for traversal over reachable states that can be shared by other functions?
-    std::list<State> worklist(initial.begin(), initial.end());
-    std::unordered_set<State> processed(initial.begin(), initial.end());
-
-    while (!worklist.empty()) {
-        State state = *worklist.begin();
-        worklist.pop_front();
-
-        size_t n = 0;      // counter of symbols
-        if (!delta.empty()) {
-            for (const auto &symb_stateset: delta[state]) {
-                ++n;
-                if (!haskey(symbols, symb_stateset.symbol)) {
-                    throw std::runtime_error(std::to_string(__func__) +
-                                             ": encountered a symbol that is not in the provided alphabet");
-                }
-
-                for (const auto &tgt_state: symb_stateset.targets) {
-                    bool inserted;
-                    tie(std::ignore, inserted) = processed.insert(tgt_state);
-                    if (inserted) { worklist.push_back(tgt_state); }
-                }
+    const utils::OrdVector<Symbol> symbols{ get_symbols_to_work_with(*this, alphabet) };
+    Traversal traversal{};
+    // Stop at the first reachable state without a transition over some symbol.
+    return !traversal.run(*this, initial, [&](const State state) {
+        for (const SymbolPost& symbol_post: delta[state]) {
+            if (!symbols.contains(symbol_post.symbol)) {
+                throw std::runtime_error(std::to_string(__func__) +
+                                         ": encountered a symbol that is not in the provided alphabet");
             }
         }
-
-        if (symbols.size() != n) { return false; }
-    }
-
-    return true;
+        return delta[state].size() != symbols.size();
+    }).has_value();
 }
 
 std::pair<Run, bool> mata::nfa::Nfa::get_word_for_path(const Run& run) const {
@@ -849,26 +958,13 @@ std::pair<Run, bool> mata::nfa::Nfa::get_word_for_path(const Run& run) const {
     return {word, true};
 }
 
-//TODO: this is not efficient
 bool mata::nfa::Nfa::is_in_lang(const Run& run) const {
-    StateSet current_post(this->initial);
-    for (const Symbol sym : run.word) {
-        current_post = this->post(current_post, sym);
-        if (current_post.empty()) { return false; }
-    }
-    return this->final.intersects_with(current_post);
+    return EpsilonClosures{ *this }.is_in_lang(run.word);
 }
 
 /// Checks whether the prefix of a string is in the language of an automaton
-// TODO: slow and it should share code with is_in_lang
 bool mata::nfa::Nfa::is_prfx_in_lang(const Run& run) const {
-    StateSet current_post{ this->initial };
-    for (const Symbol sym : run.word) {
-        if (this->final.intersects_with(current_post)) { return true; }
-        current_post = this->post(current_post, sym);
-        if (current_post.empty()) { return false; }
-    }
-    return this->final.intersects_with(current_post);
+    return EpsilonClosures{ *this }.is_prfx_in_lang(run.word);
 }
 
 bool mata::nfa::Nfa::is_lang_empty(Run* cex) const {
@@ -878,55 +974,133 @@ bool mata::nfa::Nfa::is_lang_empty(Run* cex) const {
         return is_lang_empty_scc();
     }
 
-    std::list<State> worklist(initial.begin(), initial.end());
-    std::unordered_set<State> processed(initial.begin(), initial.end());
+    Traversal traversal{};
+    const std::optional<State> final_state{
+        traversal.run(*this, initial, [&](const State state) { return final.contains(state); }) };
+    if (!final_state.has_value()) { return true; }
+    cex->path = traversal.path_to(*final_state);
+    // The word keeps the epsilon symbols, so that it corresponds to the path.
+    cex->word = traversal.symbols_to(*final_state);
+    return false;
+} // is_lang_empty().
 
-    // 'paths[s] == t' denotes that state 's' was accessed from state 't',
-    // 'paths[s] == s' means that 's' is an initial state
-    std::map<State, State> paths;
-    // Initialize paths.
-    for (const State s: worklist) { paths[s] = s; }
 
-    State state;
-    while (!worklist.empty()) {
-        state = worklist.front();
-        worklist.pop_front();
-
-        if (final[state]) {
-            if (nullptr != cex) {
-                cex->path.clear();
-                cex->path.push_back(state);
-                while (paths[state] != state) {
-                    state = paths[state];
-                    cex->path.push_back(state);
-                }
-                std::reverse(cex->path.begin(), cex->path.end());
-                cex->word = this->get_word_for_path(*cex).first.word;
+Nfa mata::nfa::algorithms::minimize_brzozowski(const Nfa& aut) {
+    //compute the minimal deterministic automaton, Brzozovski algorithm
+    return determinize(determinize_backward(aut));
+}
+
+namespace {
+    /**
+     * Concurrent map from signatures of states to new blocks, split into independently locked shards.
+     *
+     * Keys are states, compared and hashed by their signatures.
+     */
+    class SignatureTable {
+    public:
+        SignatureTable(const std::vector<std::vector<size_t>>& signatures, const size_t num_of_shards)
+            : signatures_{ signatures }, shards_(num_of_shards), next_block_{ 0 } {
+            for (Shard& shard: shards_) {
+                shard.map = SignatureMap{ 0, SignatureHash{ &signatures_ }, SignatureEqual{ &signatures_ } };
             }
-            return false;
         }
 
-        if (delta.empty()) { continue; }
+        /// Get the block of states with the signature of @p state, creating a new one if there is none.
+        size_t find_or_insert(const State state) {
+            const size_t hash{ SignatureHash{ &signatures_ }(state) };
+            Shard& shard{ shards_[hash % shards_.size()] };
+            std::lock_guard<std::mutex> lock{ shard.mutex };
+            const auto [it, inserted]{ shard.map.try_emplace(state, 0) };
+            if (inserted) { it->second = next_block_.fetch_add(1); }
+            return it->second;
+        }
 
-        for (const SymbolPost& symbol_post: delta[state]) {
-            for (const State& target: symbol_post.targets) {
-                bool inserted;
-                tie(std::ignore, inserted) = processed.insert(target);
-                if (inserted) {
-                    worklist.push_back(target);
-                    // Also set that tgt_state was accessed from state.
-                    paths[target] = state;
-                } else { assert(haskey(paths, target)); /* Invariant. */ }
+        size_t num_of_blocks() const { return next_block_.load(); }
+
+    private:
+        struct SignatureHash {
+            const std::vector<std::vector<size_t>>* signatures;
+            size_t operator()(const State state) const {
+                return mata::utils::hash_range((*signatures)[state].begin(), (*signatures)[state].end());
             }
-        }
-    } // while (!worklist.empty()).
-    return true;
-} // is_lang_empty().
+        };
+        struct SignatureEqual {
+            const std::vector<std::vector<size_t>>* signatures;
+            bool operator()(const State lhs, const State rhs) const { return (*signatures)[lhs] == (*signatures)[rhs]; }
+        };
+        using SignatureMap = std::unordered_map<State, size_t, SignatureHash, SignatureEqual>;
+        struct Shard {
+            std::mutex mutex{};
+            SignatureMap map{};
+        };
+
+        const std::vector<std::vector<size_t>>& signatures_;
+        std::vector<Shard> shards_;
+        std::atomic<size_t> next_block_;
+    };
+}
 
+Nfa mata::nfa::algorithms::minimize_moore(const Nfa& aut, const size_t num_of_threads) {
+    Nfa dfa{ aut.is_deterministic() ? aut : determinize(aut) };
+    dfa.trim();
+    const size_t num_of_states{ dfa.num_of_states() };
+    if (num_of_states == 0) { return Nfa{}; }
+
+    constexpr size_t NO_BLOCK{ std::numeric_limits<size_t>::max() };
+    // Blocks are numbered by their smallest state, so that the result does not depend on the number of threads.
+    std::vector<size_t> block_of(num_of_states);
+    size_t num_of_blocks{ 0 };
+    auto renumber = [&](std::vector<size_t>& blocks) {
+        std::vector<size_t> renaming(num_of_states, NO_BLOCK);
+        num_of_blocks = 0;
+        for (size_t& block: blocks) {
+            if (renaming[block] == NO_BLOCK) { renaming[block] = num_of_blocks++; }
+            block = renaming[block];
+        }
+    };
+    for (State state{ 0 }; state < num_of_states; ++state) { block_of[state] = dfa.final.contains(state) ? 1 : 0; }
+    renumber(block_of);
+
+    // Signature of a state: its block followed by pairs of symbols and blocks of targets. Missing transitions lead to
+    //  the (implicit) sink state.
+    std::vector<std::vector<size_t>> signatures(num_of_states);
+    std::vector<size_t> new_block_of(num_of_states);
+    while (true) {
+        parallel_for(num_of_states, num_of_threads, [&](const size_t state, size_t) {
+            std::vector<size_t>& signature{ signatures[state] };
+            signature.clear();
+            signature.push_back(block_of[state]);
+            for (const SymbolPost& symbol_post: dfa.delta[state]) {
+                signature.push_back(symbol_post.symbol);
+                signature.push_back(block_of[symbol_post.targets.front()]);
+            }
+        });
+        SignatureTable table{ signatures, std::max(size_t{ 1 }, num_of_threads * 16) };
+        parallel_for(num_of_states, num_of_threads, [&](const size_t state, size_t) {
+            new_block_of[state] = table.find_or_insert(state);
+        });
+        const size_t previous_num_of_blocks{ num_of_blocks };
+        renumber(new_block_of);
+        std::swap(block_of, new_block_of);
+        // Blocks are only split, so the partition is stable once the number of blocks does not grow.
+        if (num_of_blocks == previous_num_of_blocks) { break; }
+    }
 
-Nfa mata::nfa::algorithms::minimize_brzozowski(const Nfa& aut) {
-    //compute the minimal deterministic automaton, Brzozovski algorithm
-    return determinize(revert(determinize(revert(aut))));
+    Nfa result{ num_of_blocks };
+    mata::BoolVector block_done(num_of_blocks, false);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        const size_t block{ block_of[state] };
+        if (block_done[block]) { continue; }
+        block_done[block] = true;
+        if (dfa.final.contains(state)) { result.final.insert(block); }
+        StatePost& state_post{ result.delta.mutable_state_post(block) };
+        for (const SymbolPost& symbol_post: dfa.delta[state]) {
+            state_post.push_back(SymbolPost{ symbol_post.symbol, StateSet{ block_of[symbol_post.targets.front()] } });
+        }
+    }
+    result.delta.release_mutable_references();
+    for (const State initial_state: dfa.initial) { result.initial.insert(block_of[initial_state]); }
+    return result;
 }
 
 Nfa mata::nfa::minimize(
@@ -944,6 +1118,10 @@ Nfa mata::nfa::minimize(
 
     const std::string& str_algo = params.at("algorithm");
     if ("brzozowski" == str_algo) {  /* default */ }
+    else if ("moore" == str_algo) {
+        const size_t num_of_threads{ haskey(params, "threads") ? parse_num_of_threads(params.at("threads")) : 1 };
+        return algorithms::minimize_moore(aut, num_of_threads);
+    }
     else {
         throw std::runtime_error(std::to_string(__func__) +
             " received an unknown value of the \"algo\" key: " + str_algo);
@@ -952,7 +1130,8 @@ Nfa mata::nfa::minimize(
     return algo(aut);
 }
 
-Nfa mata::nfa::intersection(const Nfa& lhs, const Nfa& rhs, const Symbol first_epsilon, std::unordered_map<std::pair<State, State>, State>  *prod_map) {
+Nfa mata::nfa::intersection(const Nfa& lhs, const Nfa& rhs, const Symbol first_epsilon,
+                            std::unordered_map<std::pair<State, State>, State> *prod_map, Context* context) {
 
     auto both_final = [&](const State lhs_state,const State rhs_state) {
         return lhs.final.contains(lhs_state) && rhs.final.contains(rhs_state);
@@ -961,17 +1140,18 @@ Nfa mata::nfa::intersection(const Nfa& lhs, const Nfa& rhs, const Symbol first_e
     if (lhs.final.empty() || lhs.initial.empty() || rhs.initial.empty() || rhs.final.empty())
         return Nfa{};
 
-    return algorithms::product(lhs, rhs, both_final, first_epsilon, prod_map);
+    return algorithms::product(lhs, rhs, both_final, first_epsilon, prod_map, context);
 }
 
-Nfa mata::nfa::union_product(const Nfa &lhs, const Nfa &rhs, const Symbol first_epsilon, std::unordered_map<std::pair<State,State>,State> *prod_map) {
+Nfa mata::nfa::union_product(const Nfa &lhs, const Nfa &rhs, const Symbol first_epsilon,
+                             std::unordered_map<std::pair<State,State>,State> *prod_map, Context* context) {
     auto one_final = [&](const State lhs_state,const State rhs_state) {
         return lhs.final.contains(lhs_state) || rhs.final.contains(rhs_state);
     };
 
     if (lhs.final.empty() || lhs.initial.empty()) { return rhs; }
     if (rhs.final.empty() || rhs.initial.empty()) { return lhs; }
-    return algorithms::product(lhs, rhs, one_final, first_epsilon, prod_map);
+    return algorithms::product(lhs, rhs, one_final, first_epsilon, prod_map, context);
 }
 
 Nfa mata::nfa::union_nondet(const Nfa &lhs, const Nfa &rhs) { return Nfa{ lhs }.unite_nondet_with(rhs); }
@@ -991,6 +1171,12 @@ Simlib::Util::BinaryRelation mata::nfa::algorithms::compute_relation(const Nfa&
     const std::string& relation = params.at("relation");
     const std::string& direction = params.at("direction");
     if ("simulation" == relation && direction == "forward") {
+        if (haskey(params, "threads")) {
+            Simlib::Util::BinaryRelation result;
+            compute_fw_direct_simulation_parallel(aut, parse_num_of_threads(params.at("threads")))
+                .build_binary_relation(result);
+            return result;
+        }
         return compute_fw_direct_simulation(aut);
     }
     else {
@@ -999,6 +1185,33 @@ Simlib::Util::BinaryRelation mata::nfa::algorithms::compute_relation(const Nfa&
     }
 }
 
+Simlib::Util::PartitionRelation mata::nfa::algorithms::compute_partition_relation(
+        const Nfa& aut, const ParameterMap& params) {
+    if (!haskey(params, "relation")) {
+        throw std::runtime_error(std::to_string(__func__) +
+                                 " requires setting the \"relation\" key in the \"params\" argument; "
+                                 "received: " + std::to_string(params));
+    }
+    if (!haskey(params, "direction")) {
+        throw std::runtime_error(std::to_string(__func__) +
+                                 " requires setting the \"direction\" key in the \"params\" argument; "
+                                 "received: " + std::to_string(params));
+    }
+
+    const std::string& relation = params.at("relation");
+    const std::string& direction = params.at("direction");
+    if ("simulation" == relation && direction == "forward") {
+        if (haskey(params, "threads")) {
+            return compute_fw_direct_simulation_parallel(aut, parse_num_of_threads(params.at("threads")));
+        }
+        return compute_fw_direct_simulation_partition(aut);
+    }
+    else {
+        throw std::runtime_error(std::to_string(__func__) +
+                                 " received an unknown value of the \"relation\" key: " + relation);
+    }
+}
+
 Nfa mata::nfa::reduce(const Nfa &aut, StateRenaming *state_renaming, const ParameterMap& params) {
     if (!haskey(params, "algorithm")) {
         throw std::runtime_error(std::to_string(__func__) +
@@ -1010,7 +1223,7 @@ Nfa mata::nfa::reduce(const Nfa &aut, StateRenaming *state_renaming, const Param
     std::unordered_map<State,State> reduced_state_map;
     const std::string& algorithm = params.at("algorithm");
     if ("simulation" == algorithm) {
-        result = reduce_size_by_simulation(aut, reduced_state_map);
+        result = reduce_size_by_simulation(aut, reduced_state_map, params);
     }
     else if ("residual" == algorithm) {
         // reduce type either 'after' or 'with' creation of residual automaton
@@ -1044,13 +1257,19 @@ Nfa mata::nfa::reduce(const Nfa &aut, StateRenaming *state_renaming, const Param
 
 Nfa mata::nfa::determinize(
     const Nfa&  aut, std::unordered_map<StateSet, State>* subset_map,
-    std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover
+    std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover,
+    Context* context
 ) {
     Nfa result{};
     //assuming all sets targets are non-empty
-    std::vector<std::pair<State, StateSet>> worklist{};
-    std::unordered_map<StateSet, State> subset_map_local{};
-    if (subset_map == nullptr) { subset_map = &subset_map_local; }
+    Context::DeterminizationBuffers local_buffers{};
+    Context::DeterminizationBuffers& buffers{ context != nullptr ? context->determinization : local_buffers };
+    std::vector<std::pair<State, StateSet>>& worklist{ buffers.worklist };
+    worklist.clear();
+    if (subset_map == nullptr) {
+        subset_map = &buffers.subset_map;
+        subset_map->clear();
+    }
 
     const StateSet S0{ aut.initial };
     const State S0id{ result.add_state() };
@@ -1102,6 +1321,7 @@ Nfa mata::nfa::determinize(
                 worklist.emplace_back(Tid, T);
             }
             result.delta.mutable_state_post(Sid).insert(SymbolPost(currentSymbol, Tid));
+            result.delta.release_mutable_references();
             if (macrostate_discover.has_value() && existingTitr == subset_map->end()
                 && !(*macrostate_discover)(result, Tid, T)) { return result; }
         }
@@ -1109,6 +1329,68 @@ Nfa mata::nfa::determinize(
     return result;
 }
 
+Nfa mata::nfa::determinize_backward(const Nfa& aut) {
+    // Subset construction of the reversal of 'aut' over the predecessors of states. A transition 'S -a-> T' of the
+    //  constructed DFA is emitted reverted, as 'T -a-> S', right into the state post of 'T'. Macrostates are processed
+    //  in the order of their ids, so the targets of every symbol post are appended in the ascending order.
+    const PredecessorIndex predecessors{ aut };
+    Nfa result{};
+    std::unordered_map<StateSet, State> subset_map{};
+    // Macrostates indexed by their ids, pointing to the keys of 'subset_map'.
+    std::vector<const StateSet*> macrostates{};
+    std::vector<StatePost> posts{};
+    std::vector<std::pair<Symbol, State>> macrostate_predecessors{};
+
+    auto get_macrostate_id = [&](StateSet macrostate) {
+        const auto [it, inserted] = subset_map.try_emplace(std::move(macrostate), macrostates.size());
+        if (inserted) {
+            if (aut.initial.intersects_with(it->first)) { result.initial.insert(it->second); }
+            macrostates.push_back(&it->first);
+            posts.emplace_back();
+        }
+        return it->second;
+    };
+    result.final.insert(get_macrostate_id(StateSet{ aut.final }));
+
+    for (State macrostate_id{ 0 }; macrostate_id < macrostates.size(); ++macrostate_id) {
+        macrostate_predecessors.clear();
+        for (const State state: *macrostates[macrostate_id]) {
+            for (size_t i{ predecessors.begins[state] }; i < predecessors.begins[state + 1]; ++i) {
+                macrostate_predecessors.emplace_back(predecessors.symbols[i], predecessors.sources[i]);
+            }
+        }
+        std::sort(macrostate_predecessors.begin(), macrostate_predecessors.end());
+        macrostate_predecessors.erase(std::unique(macrostate_predecessors.begin(), macrostate_predecessors.end()),
+                                      macrostate_predecessors.end());
+
+        // Predecessors of the macrostate are grouped by symbols, and the sources of each group are already sorted.
+        for (auto group_begin{ macrostate_predecessors.begin() }; group_begin != macrostate_predecessors.end();) {
+            const Symbol symbol{ group_begin->first };
+            const auto group_end{ std::find_if(group_begin, macrostate_predecessors.end(),
+                                               [&](const auto& predecessor) { return predecessor.first != symbol; }) };
+            StateSet predecessor_macrostate{ StateSet::with_reserved(static_cast<size_t>(group_end - group_begin)) };
+            for (auto it{ group_begin }; it != group_end; ++it) { predecessor_macrostate.push_back(it->second); }
+            const State predecessor_id{ get_macrostate_id(std::move(predecessor_macrostate)) };
+
+            StatePost& post{ posts[predecessor_id] };
+            const auto symbol_post{ std::lower_bound(
+                post.begin(), post.end(), symbol,
+                [](const SymbolPost& symbol_post, const Symbol symbol) { return symbol_post.symbol < symbol; }) };
+            if (symbol_post != post.end() && symbol_post->symbol == symbol) {
+                symbol_post->targets.push_back(macrostate_id);
+            } else {
+                post.insert(symbol_post, SymbolPost{ symbol, StateSet{ macrostate_id } });
+            }
+            group_begin = group_end;
+        }
+    }
+
+    result.delta.reserve(posts.size());
+    for (StatePost& post: posts) { result.delta.emplace_back(std::move(post)); }
+    result.delta.release_mutable_references();
+    return result;
+}
+
 std::ostream& std::operator<<(std::ostream& os, const Nfa& nfa) {
     nfa.print_to_mata(os);
     return os;
@@ -1208,26 +1490,11 @@ OrdVector<Symbol> mata::nfa::get_symbols_to_work_with(const Nfa& nfa, const mata
 std::optional<mata::Word> Nfa::get_word(const Symbol first_epsilon) const {
     if (initial.empty() || final.empty()) { return std::nullopt; }
 
-    std::vector<std::pair<State, Word>> worklist{};
-    for (const State initial_state: initial) {
-        if (final.contains(initial_state)) { return Word{}; }
-        worklist.emplace_back(initial_state, Word{});
-    }
-    std::vector<bool> searched(num_of_states());
-
-    while (!worklist.empty()) {
-        auto [state, word]{ std::move(worklist.back()) };
-        worklist.pop_back();
-        for (const Move move: delta[state].moves()) {
-            if (searched[move.target]) { continue; }
-            Word target_word{ word };
-            if (move.symbol < first_epsilon) { target_word.push_back(move.symbol); }
-            if (final.contains(move.target)) { return target_word; }
-            worklist.emplace_back(move.target, target_word);
-            searched[move.target] = true;
-        }
-    }
-    return std::nullopt;
+    Traversal traversal{ Traversal::Order::DFS, first_epsilon };
+    const std::optional<State> final_state{
+        traversal.run(*this, initial, [&](const State state) { return final.contains(state); }) };
+    if (!final_state.has_value()) { return std::nullopt; }
+    return traversal.word_to(*final_state);
 }
 
 std::optional<mata::Word> Nfa::get_word_from_complement(const Alphabet* alphabet) const {
@@ -4,8 +4,10 @@
 // MATA headers
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/context.hh"
 #include <cassert>
 #include <functional>
+#include <optional>
 
 
 using namespace mata::nfa;
@@ -13,9 +15,7 @@ using namespace mata::nfa;
 namespace {
 
 using ProductMap = std::unordered_map<std::pair<State,State>,State>;
-using MatrixProductStorage = std::vector<std::vector<State>>;
 using VecMapProductStorage = std::vector<std::unordered_map<State,State>>;
-using InvertedProductStorage = std::vector<State>;
 //Unordered map seems to be faster than ordered map here, but still very much slower than matrix.
 
 } // Anonymous namespace.
@@ -25,12 +25,17 @@ namespace mata::nfa {
 //TODO: move this method to nfa.hh? It is something one might want to use (e.g. for union, inclusion, equivalence of DFAs).
 Nfa mata::nfa::algorithms::product(
         const Nfa& lhs, const Nfa& rhs, const std::function<bool(State,State)>&& final_condition,
-        const Symbol first_epsilon, ProductMap *product_map) {
+        const Symbol first_epsilon, ProductMap *product_map, mata::Context* context) {
 
     Nfa product{}; // The product automaton.
 
+    // Temporaries are kept in the context if there is one.
+    mata::Context::ProductBuffers local_buffers{};
+    mata::Context::ProductBuffers& buffers{ context != nullptr ? context->product : local_buffers };
+
     // Set of product states to process.
-    std::deque<State> worklist{};
+    std::vector<State>& worklist{ buffers.worklist };
+    worklist.clear();
 
     //The largest matrix (product_matrix) of pairs of states we are brave enough to allocate.
     // Let's say we are fine with allocating large_product * (about 8 Bytes) space.
@@ -44,23 +49,49 @@ Nfa mata::nfa::algorithms::product(
     assert(rhs.num_of_states() < Limits::max_state);
 
     //Two variants of storage for the mapping from pairs of lhs and rhs states to product state, for large and non-large products.
-    MatrixProductStorage matrix_product_storage;
+    // The matrix is flat, a pair (lhs_state, rhs_state) is at 'lhs_state * rhs_num_of_states + rhs_state'. All its
+    //  items are Limits::max_state outside of this function, the items set here are reset by 'matrix_reset'.
+    const size_t rhs_num_of_states{ rhs.num_of_states() };
+    std::vector<State>& matrix_product_storage{ buffers.matrix };
     VecMapProductStorage vec_map_product_storage;
-    InvertedProductStorage product_to_lhs(lhs.num_of_states()+rhs.num_of_states());
-    InvertedProductStorage product_to_rhs(lhs.num_of_states()+rhs.num_of_states());
-
+    std::vector<State>& product_to_lhs{ buffers.product_to_lhs };
+    std::vector<State>& product_to_rhs{ buffers.product_to_rhs };
+    product_to_lhs.clear();
+    product_to_rhs.clear();
 
     //Initialize the storage, according to the number of possible state pairs.
-    if (!large_product)
-        matrix_product_storage = MatrixProductStorage(lhs.num_of_states(), std::vector<State>(rhs.num_of_states(), Limits::max_state));
-    else
+    if (!large_product) {
+        const size_t matrix_size{ lhs.num_of_states() * rhs_num_of_states };
+        if (matrix_product_storage.size() < matrix_size) { matrix_product_storage.resize(matrix_size, Limits::max_state); }
+    } else {
         vec_map_product_storage = VecMapProductStorage(lhs.num_of_states());
+    }
+
+    // Reset the items of the matrix set by this call when leaving the function, also when an exception is thrown, so
+    //  that the matrix of a context is clean for the next product.
+    struct MatrixReset {
+        std::vector<State>& matrix;
+        const std::vector<State>& product_to_lhs;
+        const std::vector<State>& product_to_rhs;
+        const size_t rhs_num_of_states;
+
+        ~MatrixReset() {
+            for (State product_state{ 0 }; product_state < product_to_lhs.size(); ++product_state) {
+                matrix[product_to_lhs[product_state] * rhs_num_of_states + product_to_rhs[product_state]] =
+                    Limits::max_state;
+            }
+        }
+    };
+    const std::optional<MatrixReset> matrix_reset{
+        large_product ? std::nullopt
+                      : std::optional<MatrixReset>{
+                            std::in_place, matrix_product_storage, product_to_lhs, product_to_rhs, rhs_num_of_states } };
 
     /// Give me the product state for the pair of lhs and rhs states.
     /// Returns Limits::max_state if not found.
     auto get_state_from_product_storage = [&](State lhs_state, State rhs_state) {
         if (!large_product)
-            return matrix_product_storage[lhs_state][rhs_state];
+            return matrix_product_storage[lhs_state * rhs_num_of_states + rhs_state];
         else {
             auto it = vec_map_product_storage[lhs_state].find(rhs_state);
             if (it == vec_map_product_storage[lhs_state].end())
@@ -72,16 +103,17 @@ Nfa mata::nfa::algorithms::product(
 
     /// Insert new mapping lhs rhs state pair to product state.
     auto insert_to_product_storage = [&](State lhs_state, State rhs_state, State product_state) {
-        if (!large_product)
-            matrix_product_storage[lhs_state][rhs_state] = product_state;
-        else
-            vec_map_product_storage[lhs_state][rhs_state] = product_state;
-
+        // The pair is recorded before it is written into the matrix, so that the matrix is always reset.
         product_to_lhs.resize(product_state+1);
         product_to_rhs.resize(product_state+1);
         product_to_lhs[product_state] = lhs_state;
         product_to_rhs[product_state] = rhs_state;
 
+        if (!large_product)
+            matrix_product_storage[lhs_state * rhs_num_of_states + rhs_state] = product_state;
+        else
+            vec_map_product_storage[lhs_state][rhs_state] = product_state;
+
         //this thing is not used internally. It is only used if we want to return the mapping. But it is expensive.
         if (product_map != nullptr)
             (*product_map)[std::pair<State,State>(lhs_state,rhs_state)] = product_state;
@@ -222,6 +254,8 @@ Nfa mata::nfa::algorithms::product(
             }
         }
     }
+
+    product.delta.release_mutable_references();
     return product;
 } // intersection().
 
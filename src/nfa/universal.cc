@@ -5,9 +5,46 @@
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/antichain.hh"
+
+#include <map>
+#include <unordered_map>
 
 using namespace mata::nfa;
 using namespace mata::utils;
+using mata::Symbol;
+
+namespace {
+	/**
+	 * Partition the symbols used by @p aut into classes of symbols with the same transitions from every state, which
+	 * hence lead from every macrostate to the same successor.
+	 * @return The class of each used symbol and the number of classes.
+	 */
+	std::pair<std::unordered_map<Symbol, size_t>, size_t> compute_symbol_classes(const Nfa& aut) {
+		// The transitions of a symbol as pairs of a source state and the targets, ordered by the source states.
+		using Transitions = std::vector<std::pair<State, const StateSet*>>;
+		std::map<Symbol, Transitions> transitions_of{};
+		for (State q = 0; q < aut.num_of_states(); ++q) {
+			for (const SymbolPost& symbol_post : aut.delta[q]) {
+				transitions_of[symbol_post.symbol].emplace_back(q, &symbol_post.targets);
+			}
+		}
+
+		auto less = [](const Transitions& lhs, const Transitions& rhs) {
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+				[](const auto& l, const auto& r) {
+					return l.first < r.first || (l.first == r.first && *l.second < *r.second);
+				});
+		};
+		std::map<Transitions, size_t, decltype(less)> class_of_transitions{ less };
+		std::unordered_map<Symbol, size_t> class_of_symbol{};
+		for (const auto& [symbol, transitions] : transitions_of) {
+			class_of_symbol[symbol] =
+				class_of_transitions.emplace(transitions, class_of_transitions.size()).first->second;
+		}
+		return { std::move(class_of_symbol), class_of_transitions.size() };
+	}
+}
 
 //TODO: this could be merged with inclusion, or even removed, universality could be implemented using inclusion,
 // it is not something needed in practice, so some little overhead is ok
@@ -31,22 +68,37 @@ bool mata::nfa::algorithms::is_universal_antichains(
 	const Alphabet&    alphabet,
 	Run*               cex)
 { // {{{
+	return is_universal_antichains(aut, alphabet, ExplorationOrder::DFS, cex);
+} // }}}
 
-	using WorklistType = std::list<StateSet>;
-	using ProcessedType = std::list<StateSet>;
+bool mata::nfa::algorithms::is_universal_antichains(
+	const Nfa&              aut,
+	const Alphabet&         alphabet,
+	const ExplorationOrder  order,
+	Run*                    cex)
+{ // {{{
 
-	auto subsumes = [](const StateSet& lhs, const StateSet& rhs) {
-		if (lhs.size() > rhs.size()) { // bigger set cannot be subset
-			return false;
+	// The worklist holds ids of macrostates in the antichain, macrostates removed from the antichain are skipped.
+	using WorklistType = Worklist<Antichain<StateSet>::Id>;
+	using ProcessedType = Antichain<StateSet>;
+
+	std::vector<State> distances{};
+	if (order == ExplorationOrder::DISTANCE) { distances = aut.distances_to_final(); }
+
+	// Priority of a macrostate for the priority orders of the worklist, macrostates with smaller priorities are
+	// processed first.
+	auto priority = [&](const StateSet& macrostate) -> size_t {
+		switch (order) {
+			case ExplorationOrder::SMALLEST_MACROSTATE: return macrostate.size();
+			case ExplorationOrder::DISTANCE: {
+				State min_distance = Limits::max_state;
+				for (const State state : macrostate) { min_distance = std::min(min_distance, distances[state]); }
+				return Limits::max_state - min_distance;
+			}
+			default: return 0;
 		}
-
-		return std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 	};
 
-	// process parameters
-	// TODO: set correctly!!!!
-	bool is_dfs = true;
-
 	// check the initial state
 	if (are_disjoint(aut.initial, aut.final)) {
 		if (nullptr != cex) { cex->word.clear(); }
@@ -54,76 +106,101 @@ bool mata::nfa::algorithms::is_universal_antichains(
 	}
 
 	// initialize
-	WorklistType worklist = { StateSet(aut.initial) };
-	ProcessedType processed = { StateSet(aut.initial) };
-	mata::utils::OrdVector<Symbol> alph_symbols = alphabet.get_alphabet_symbols();
-
-	// 'paths[s] == t' denotes that state 's' was accessed from state 't',
-	// 'paths[s] == s' means that 's' is an initial state
-	std::map<StateSet, std::pair<StateSet, Symbol>> paths =
-		{ {StateSet(aut.initial), {StateSet(aut.initial), 0}} };
+	ProcessedType processed{};
+	WorklistType worklist{ get_worklist_order(order) };
+	const Antichain<StateSet>::Id initial_id = processed.insert(StateSet(aut.initial));
+	worklist.push(initial_id, priority(processed.get(initial_id)));
+	const mata::utils::OrdVector<Symbol> alph_symbols = alphabet.get_alphabet_symbols();
+
+	// 'parents[s] == {t, a}' denotes that the macrostate with id 's' was accessed from the macrostate with id 't'
+	// over 'a', the initial macrostate is its own parent. Ids of macrostates are handed out by the antichain.
+	std::vector<std::pair<Antichain<StateSet>::Id, Symbol>> parents{};
+	if (nullptr != cex) { parents.emplace_back(initial_id, 0); }
+
+	// Set the counterexample to the word reaching the macrostate with 'state_id' followed by 'symb'.
+	auto set_cex = [&](const Antichain<StateSet>::Id state_id, const Symbol symb) {
+		if (nullptr == cex) { return; }
+		cex->word.clear();
+		cex->word.push_back(symb);
+		for (Antichain<StateSet>::Id trav = state_id; parents[trav].first != trav; trav = parents[trav].first)
+		{ // go back until initial state
+			cex->word.push_back(parents[trav].second);
+		}
+		std::reverse(cex->word.begin(), cex->word.end());
+	};
 
+	// The successor of a macrostate is computed once per class of symbols with the same transitions, from the first
+	// symbol of the class met. 'class_done[c]' marks the classes whose successor was computed for the current
+	// macrostate, they are listed in 'done_classes' to reset the marks.
+	const auto [class_of_symbol, num_of_symbol_classes] = compute_symbol_classes(aut);
+	std::vector<bool> class_done(num_of_symbol_classes, false);
+	std::vector<size_t> done_classes{};
+
+	// Symbols with the same successor form a single class of the macrostate: 'successors[i]' is the successor of the
+	// class 'i' and 'class_symbols[i]' is the first symbol of the class.
+	std::vector<StateSet> successors{};
+	std::vector<Symbol> class_symbols{};
+	std::unordered_map<StateSet, size_t> class_of_successor{};
+	SynchronizedExistentialSymbolPostIterator sync_iterator{};
 	while (!worklist.empty()) {
 		// get a next state
-		StateSet state;
-		if (is_dfs) {
-			state = *worklist.rbegin();
-			worklist.pop_back();
-		} else { // BFS
-			state = *worklist.begin();
-			worklist.pop_front();
-		}
-
-		// process it
-		for (Symbol symb : alph_symbols) {
-			StateSet succ = aut.post(state, symb);
-			if (!aut.final.intersects_with(succ)) {
-				if (nullptr != cex) {
-					cex->word.clear();
-					cex->word.push_back(symb);
-					StateSet trav = state;
-					while (paths[trav].first != trav)
-					{ // go back until initial state
-						cex->word.push_back(paths[trav].second);
-						trav = paths[trav].first;
-					}
-
-					std::reverse(cex->word.begin(), cex->word.end());
-				}
-
+		const Antichain<StateSet>::Id state_id = worklist.pop();
+		if (!processed.is_alive(state_id)) { continue; }
+		const StateSet& state = processed.get(state_id);
+
+		// process it: a single merged scan of the posts of its states gives all the used symbols together with
+		// their successors, and the symbols of the alphabet are matched against them along the way
+		successors.clear();
+		class_symbols.clear();
+		class_of_successor.clear();
+		for (const size_t symbol_class : done_classes) { class_done[symbol_class] = false; }
+		done_classes.clear();
+		sync_iterator.reset();
+		for (const State q : state) { mata::utils::push_back(sync_iterator, aut.delta[q]); }
+		auto alph_it = alph_symbols.begin();
+		while (alph_it != alph_symbols.end() && sync_iterator.advance()) {
+			const Symbol symb = sync_iterator.get_current()[0]->symbol;
+			if (*alph_it < symb) {
+				// a symbol of the alphabet used by no state of the macrostate leads to the empty macrostate
+				set_cex(state_id, *alph_it);
 				return false;
 			}
-
-			bool is_subsumed = false;
-			for (const auto& anti_state : processed) {
-				// trying to find a smaller state in processed
-				if (subsumes(anti_state, succ)) {
-					is_subsumed = true;
-					break;
-				}
+			if (symb < *alph_it) { continue; } // a symbol outside the alphabet
+			++alph_it;
+
+			const size_t symbol_class = class_of_symbol.at(symb);
+			if (class_done[symbol_class]) { continue; } // the successor is the one of an earlier symbol
+			class_done[symbol_class] = true;
+			done_classes.push_back(symbol_class);
+
+			StateSet succ = sync_iterator.unify_targets();
+			if (class_of_successor.emplace(succ, successors.size()).second) {
+				successors.push_back(std::move(succ));
+				class_symbols.push_back(symb);
 			}
+		}
+		if (alph_it != alph_symbols.end()) {
+			set_cex(state_id, *alph_it);
+			return false;
+		}
 
-			if (is_subsumed) { continue; }
-
-			// prune data structures and insert succ inside
-			for (std::list<StateSet>* ds : {&processed, &worklist}) {
-				auto it = ds->begin();
-				while (it != ds->end()) {
-					if (subsumes(succ, *it)) {
-						auto to_remove = it;
-						++it;
-						ds->erase(to_remove);
-					} else {
-						++it;
-					}
-				}
-
-				// TODO: set pushing strategy
-				ds->push_back(succ);
+		for (size_t i = 0; i < successors.size(); ++i) {
+			if (!aut.final.intersects_with(successors[i])) {
+				set_cex(state_id, class_symbols[i]);
+				return false;
 			}
+		}
 
-			// also set that succ was accessed from state
-			paths[succ] = {state, symb};
+		// insert the successors not subsumed by the antichain and prune it in one batch
+		const std::vector<Antichain<StateSet>::Id> succ_ids = processed.insert_batch(std::move(successors));
+		for (size_t i = 0; i < succ_ids.size(); ++i) {
+			if (succ_ids[i] == Antichain<StateSet>::NO_ID) { continue; }
+			worklist.push(succ_ids[i], priority(processed.get(succ_ids[i])));
+			if (nullptr != cex) {
+				// also set that succ was accessed from state
+				parents.resize(succ_ids[i] + 1);
+				parents[succ_ids[i]] = {state_id, class_symbols[i]};
+			}
 		}
 	}
 
@@ -143,6 +220,10 @@ bool mata::nfa::Nfa::is_universal(const Alphabet& alphabet, Run* cex, const Para
 	const std::string& str_algo = params.at("algorithm");
 	if ("naive" == str_algo) { /* default */ }
 	else if ("antichains" == str_algo) {
+		if (haskey(params, "exploration")) {
+			return algorithms::is_universal_antichains(
+				*this, alphabet, algorithms::parse_exploration_order(params.at("exploration")), cex);
+		}
 		algo = algorithms::is_universal_antichains;
 	} else {
 		throw std::runtime_error(std::to_string(__func__) +
@@ -44,10 +44,41 @@ int main(int argc, char *argv[]) {
     mata::nfa::is_included(lhs, rhs, &alphabet, params);
     TIME_END(automata_inclusion_naive);
 
+    params["algorithm"] = "naive-lazy";
+    TIME_BEGIN(automata_inclusion_naive_lazy);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_naive_lazy);
+
     params["algorithm"] = "antichains";
     TIME_BEGIN(automata_inclusion_antichain);
     mata::nfa::is_included(lhs, rhs, &alphabet, params);
     TIME_END(automata_inclusion_antichain);
 
+    params["exploration"] = "bfs";
+    TIME_BEGIN(automata_inclusion_antichain_bfs);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_antichain_bfs);
+
+    params["exploration"] = "smallest";
+    TIME_BEGIN(automata_inclusion_antichain_smallest);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_antichain_smallest);
+
+    params["exploration"] = "distance";
+    TIME_BEGIN(automata_inclusion_antichain_distance);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_antichain_distance);
+    params.erase("exploration");
+
+    params["algorithm"] = "antichains-sim";
+    TIME_BEGIN(automata_inclusion_antichain_sim);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_antichain_sim);
+
+    params["algorithm"] = "congruence";
+    TIME_BEGIN(automata_inclusion_congruence);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_congruence);
+
     return EXIT_SUCCESS;
 }
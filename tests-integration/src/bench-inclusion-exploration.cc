@@ -0,0 +1,41 @@
+/**
+ * Benchmark: Exploration orders of antichain inclusion (b-incl-*)
+ *
+ * The benchmark program measures the antichain inclusion check of two automata with a single exploration order
+ *  ("dfs", "bfs", "smallest" or "distance"), so that the orders can be compared as separate jobs of
+ *  jobs/bench-inclusion-exploration.yaml.
+ *
+ * Optimal Inputs: inputs/bench-double-automata-inclusion.in
+ *
+ * NOTE: Input automata, that are of type `NFA-bits` are mintermized!
+ *  - If you want to skip mintermization, set the variable `MINTERMIZE_AUTOMATA` below to `false`
+ */
+
+#include "utils/utils.hh"
+
+constexpr bool MINTERMIZE_AUTOMATA{ true};
+
+int main(int argc, char *argv[]) {
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <smaller> <bigger> <exploration>\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> filenames {argv[1], argv[2]};
+    std::vector<Nfa> automata;
+    mata::OnTheFlyAlphabet alphabet;
+    if (load_automata(filenames, automata, alphabet, MINTERMIZE_AUTOMATA) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    const ParameterMap params{ { "algorithm", "antichains" }, { "exploration", argv[3] } };
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    TIME_BEGIN(automata_inclusion);
+    mata::nfa::is_included(automata[0], automata[1], &alphabet, params);
+    TIME_END(automata_inclusion);
+
+    return EXIT_SUCCESS;
+}
@@ -7,6 +7,7 @@
 #include "utils/utils.hh"
 
 #include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
 
 #include <iostream>
 #include <string>
@@ -39,5 +40,16 @@ int main(int argc, char *argv[]) {
     aut_min = mata::nfa::minimize(aut_min);
     std::cout << "minimize:" << (mata::nfa::are_equivalent(aut, aut_min) ? "ok" : "fail") << std::endl;
 
+    // Moore minimization test
+    Nfa aut_min_moore = mata::nfa::minimize(aut, { { "algorithm", "moore" }, { "threads", "4" } });
+    std::cout << "minimize-moore:" << (aut_min_moore.num_of_states() == aut_min.num_of_states()
+                                       && mata::nfa::are_equivalent(aut, aut_min_moore) ? "ok" : "fail") << std::endl;
+
+    // parallel simulation test
+    const auto simulation = mata::nfa::algorithms::compute_partition_relation(aut);
+    const auto simulation_parallel = mata::nfa::algorithms::compute_partition_relation(
+        aut, { { "relation", "simulation" }, { "direction", "forward" }, { "threads", "4" } });
+    std::cout << "simulation-threads:" << (simulation == simulation_parallel ? "ok" : "fail") << std::endl;
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include "mata/utils/antichain.hh"
+#include "mata/nfa/nfa.hh"
+
+#include "nfa/utils.hh"
+
+using namespace mata::utils;
+using namespace mata::nfa;
+
+namespace {
+    std::vector<StateSet> stored_sets(const Antichain<StateSet>& antichain) {
+        std::vector<StateSet> result;
+        antichain.for_each([&](Antichain<StateSet>::Id, const StateSet& set) { result.push_back(set); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST_CASE("mata::utils::Antichain") {
+    using Id = Antichain<StateSet>::Id;
+    Antichain<StateSet> antichain;
+
+    SECTION("insert") {
+        const Id id_123{ antichain.insert({ 1, 2, 3 }) };
+        CHECK(id_123 != Antichain<StateSet>::NO_ID);
+        CHECK(antichain.insert({ 1, 2, 3 }) == Antichain<StateSet>::NO_ID);
+        CHECK(antichain.insert({ 1, 2, 3, 4 }) == Antichain<StateSet>::NO_ID);
+        const Id id_45{ antichain.insert({ 4, 5 }) };
+        CHECK(antichain.size() == 2);
+        CHECK(antichain.contains_subset_of({ 0, 4, 5 }));
+        CHECK(!antichain.contains_subset_of({ 1, 2, 4 }));
+
+        const Id id_2{ antichain.insert({ 2 }) };
+        CHECK(!antichain.is_alive(id_123));
+        CHECK(antichain.is_alive(id_45));
+        CHECK(antichain.get(id_2) == StateSet{ 2 });
+        CHECK(stored_sets(antichain) == std::vector<StateSet>{ { 2 }, { 4, 5 } });
+
+        antichain.insert({});
+        CHECK(stored_sets(antichain) == std::vector<StateSet>{ {} });
+        CHECK(antichain.contains_subset_of({ 7 }));
+        antichain.clear();
+        CHECK(antichain.empty());
+    }
+
+    SECTION("insert_batch") {
+        antichain.insert({ 1, 2, 3 });
+        antichain.insert({ 5, 6 });
+        const std::vector<Id> ids{ antichain.insert_batch({ { 1, 2 }, { 5, 6, 7 }, { 1, 2, 4 }, { 1, 2 }, { 8 } }) };
+        REQUIRE(ids.size() == 5);
+        CHECK(ids[0] != Antichain<StateSet>::NO_ID);
+        CHECK(ids[1] == Antichain<StateSet>::NO_ID);
+        CHECK(ids[2] == Antichain<StateSet>::NO_ID);
+        CHECK(ids[3] == Antichain<StateSet>::NO_ID);
+        CHECK(ids[4] != Antichain<StateSet>::NO_ID);
+        CHECK(stored_sets(antichain) == std::vector<StateSet>{ { 1, 2 }, { 5, 6 }, { 8 } });
+    }
+
+    SECTION("matches naive minimal sets") {
+        std::vector<StateSet> all_sets;
+        RandomGenerator random{ 11 };
+        while (all_sets.size() < 64) {
+            const size_t bits{ random.next() >> 40 };
+            StateSet set;
+            for (State bit{ 0 }; bit < 10; ++bit) { if (bits & (size_t{ 1 } << bit)) { set.insert(bit * 70); } }
+            if (set.size() >= 4) { all_sets.push_back(set); }
+        }
+        std::vector<StateSet> batch;
+        for (size_t i{ 0 }; i < all_sets.size(); ++i) {
+            if (i % 2 == 0) { antichain.insert(all_sets[i]); } else { batch.push_back(all_sets[i]); }
+            if (batch.size() == 4) { antichain.insert_batch(batch); batch.clear(); }
+        }
+        std::vector<StateSet> expected;
+        for (const StateSet& set: all_sets) {
+            const bool minimal = std::none_of(all_sets.begin(), all_sets.end(), [&](const StateSet& other) {
+                return other != set && other.is_subset_of(set);
+            });
+            if (minimal && std::find(expected.begin(), expected.end(), set) == expected.end()) {
+                expected.push_back(set);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        CHECK(stored_sets(antichain) == expected);
+    }
+}
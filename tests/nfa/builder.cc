@@ -102,3 +102,63 @@ TEST_CASE("parse_from_mata()") {
         }
     }
 }
+
+TEST_CASE("mata::nfa::builder::create_minimal_acyclic_dfa()") {
+    std::vector<Word> words;
+    Nfa expected;
+
+    SECTION("no words") {
+        const Nfa result{ builder::create_minimal_acyclic_dfa(words) };
+        CHECK(result.num_of_states() == 1);
+        CHECK(result.initial == mata::utils::SparseSet<State>{ 0 });
+        CHECK(result.final.empty());
+        CHECK(result.delta.empty());
+    }
+
+    SECTION("words with common prefixes and suffixes") {
+        words = { {}, { 'a' }, { 'a', 'b', 'c' }, { 'a', 'b', 'd' }, { 'a', 'c' }, { 'b', 'b', 'c' }, { 'b', 'b', 'd' },
+                  { 'b', 'c' }, { 'c', 'a', 'b', 'c' } };
+        for (const Word& word: words) { expected.unite_nondet_with(builder::create_single_word_nfa(word)); }
+
+        const Nfa result{ builder::create_minimal_acyclic_dfa(words) };
+        CHECK(result.is_deterministic());
+        CHECK(are_equivalent(result, expected));
+        CHECK(result.num_of_states() == minimize(expected).num_of_states());
+
+        SECTION("unsorted words give the same automaton") {
+            std::vector<Word> unsorted_words{ words.rbegin(), words.rend() };
+            std::swap(unsorted_words[2], unsorted_words[5]);
+            unsorted_words.push_back({ 'a', 'c' });
+            CHECK(builder::create_minimal_acyclic_dfa(unsorted_words, false).is_identical(result));
+            CHECK_THROWS_AS(builder::create_minimal_acyclic_dfa(unsorted_words), std::runtime_error);
+        }
+    }
+
+    SECTION("generated words") {
+        for (Symbol first{ 0 }; first < 5; ++first) {
+            for (Symbol second{ 0 }; second < 7; ++second) {
+                for (Symbol third{ 0 }; third < 3; ++third) {
+                    if ((first + second * third) % 4 != 1) { words.push_back({ first, second, third }); }
+                    if ((first * second + third) % 5 == 2) { words.push_back({ first, second, third, first }); }
+                }
+            }
+        }
+        std::sort(words.begin(), words.end());
+        for (const Word& word: words) { expected.unite_nondet_with(builder::create_single_word_nfa(word)); }
+
+        builder::MinimalAcyclicDfaBuilder sorted_builder{};
+        builder::MinimalAcyclicDfaBuilder unsorted_builder{ false };
+        for (const Word& word: words) { sorted_builder.add_word(word); }
+        for (size_t i{ 0 }; i < words.size(); ++i) { // Alternately from the start and from the end.
+            unsorted_builder.add_word(i % 2 == 0 ? words[i / 2] : words[words.size() - 1 - i / 2]);
+        }
+        const Nfa sorted_result{ sorted_builder.build() };
+        const Nfa unsorted_result{ unsorted_builder.build() };
+
+        CHECK(sorted_result.is_deterministic());
+        CHECK(are_equivalent(sorted_result, expected));
+        CHECK(sorted_result.num_of_states() == minimize(expected).num_of_states());
+        CHECK(unsorted_result.is_identical(sorted_result));
+        CHECK(sorted_builder.num_of_states() == 1);
+    }
+}
@@ -7,6 +7,8 @@
 #include <catch2/catch.hpp>
 
 #include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/context.hh"
 
 using namespace mata::nfa;
 using namespace mata::utils;
@@ -272,6 +274,32 @@ TEST_CASE("mata::nfa::intersection() with preserving epsilon transitions")
     CHECK(result.delta.state_post(prod_map[{ 5, 8 }]).empty());
 }
 
+TEST_CASE("mata::nfa::intersection() with a context")
+{
+    mata::Context context{};
+    Nfa a{ 6 }, b{ 14 };
+    FILL_WITH_AUT_A(a);
+    FILL_WITH_AUT_B(b);
+    b.delta.add(5, EPSILON, 6);
+
+    // The context is reused by products of automata of different sizes, in both orders.
+    for (size_t i{ 0 }; i < 3; ++i) {
+        CHECK(intersection(a, b, EPSILON, nullptr, &context).is_identical(intersection(a, b)));
+        CHECK(intersection(b, a, EPSILON, nullptr, &context).is_identical(intersection(b, a)));
+        CHECK(union_product(a, b, EPSILON, nullptr, &context).is_identical(union_product(a, b)));
+        CHECK(intersection(a, a, EPSILON, nullptr, &context).is_identical(intersection(a, a)));
+    }
+    CHECK(std::all_of(context.product.matrix.begin(), context.product.matrix.end(),
+                      [](const State state) { return state == Limits::max_state; }));
+
+    // The matrix is reset also when the product is left by an exception.
+    CHECK_THROWS(mata::nfa::algorithms::product(
+        a, b, [](State, State) -> bool { throw std::runtime_error("final condition"); }, EPSILON, nullptr, &context));
+    CHECK(std::all_of(context.product.matrix.begin(), context.product.matrix.end(),
+                      [](const State state) { return state == Limits::max_state; }));
+    CHECK(intersection(a, b, EPSILON, nullptr, &context).is_identical(intersection(a, b)));
+}
+
 TEST_CASE("mata::nfa::intersection() for profiling", "[.profiling],[intersection]")
 {
     Nfa a{6};
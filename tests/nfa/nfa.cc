@@ -7,8 +7,10 @@
 #include "utils.hh"
 
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/parallel.hh"
 #include "mata/nfa/delta.hh"
 #include "mata/nfa/nfa.hh"
+#include "mata/context.hh"
 #include "mata/nfa/strings.hh"
 #include "mata/nfa/builder.hh"
 #include "mata/nfa/plumbing.hh"
@@ -268,6 +270,18 @@ TEST_CASE("mata::nfa::is_lang_empty()")
         REQUIRE(cex.path[1] == 4);
         REQUIRE(cex.path[2] == 8);
     }
+
+    SECTION("Counterexample with epsilon transitions keeps the epsilon symbols")
+    {
+        aut.initial = {1};
+        aut.final = {3};
+        aut.delta.add(1, EPSILON, 2);
+        aut.delta.add(2, 'a', 3);
+
+        REQUIRE(!aut.is_lang_empty(&cex));
+        CHECK(cex.path == std::vector<State>{ 1, 2, 3 });
+        CHECK(cex.word == Word{ EPSILON, 'a' });
+    }
 } // }}}
 
 TEST_CASE("mata::nfa::is_acyclic")
@@ -376,6 +390,28 @@ TEST_CASE("mata::nfa::is_flat")
     }
 } // }}}
 
+TEST_CASE("mata::nfa::Nfa::get_condensation()") {
+    Nfa aut(6, { 0 }, { 4 });
+    aut.delta.add(0, 'a', 1);
+    aut.delta.add(1, 'b', 0);
+    aut.delta.add(1, 'a', 2);
+    aut.delta.add(2, 'a', 4);
+    aut.delta.add(4, 'b', 4);
+    aut.delta.add(5, 'a', 0);
+
+    const mata::utils::Condensation<State> condensation{ aut.get_condensation() };
+    REQUIRE(condensation.num_of_sccs() == 3);
+    CHECK(condensation.scc_of[0] == 0);
+    CHECK(condensation.scc_of[1] == 0);
+    CHECK(condensation.scc_of[2] == 1);
+    CHECK(condensation.scc_of[4] == 2);
+    CHECK(condensation.scc_of[3] == mata::utils::Condensation<State>::NO_SCC);
+    CHECK(condensation.scc_of[5] == mata::utils::Condensation<State>::NO_SCC);
+    CHECK(condensation.cyclic == std::vector<bool>{ true, false, true });
+    CHECK(condensation.scc_successors(0).size() == 1);
+    CHECK(condensation.scc_successors(0)[0] == 1);
+}
+
 TEST_CASE("mata::nfa::get_word_for_path()")
 { // {{{
     Nfa aut(5);
@@ -539,6 +575,72 @@ TEST_CASE("mata::nfa::determinize()")
     }
 } // }}}
 
+TEST_CASE("mata::nfa::determinize() with a context")
+{
+    mata::Context context{};
+    Nfa aut{ 20 };
+    FILL_WITH_AUT_A(aut);
+    Nfa other{ 20 };
+    FILL_WITH_AUT_B(other);
+
+    for (size_t i{ 0 }; i < 3; ++i) {
+        CHECK(determinize(aut, nullptr, std::nullopt, &context).is_identical(determinize(aut)));
+        CHECK(determinize(other, nullptr, std::nullopt, &context).is_identical(determinize(other)));
+    }
+    std::unordered_map<StateSet, State> subset_map{};
+    const Nfa result{ determinize(aut, &subset_map, std::nullopt, &context) };
+    CHECK(subset_map.size() == result.num_of_states());
+}
+
+TEST_CASE("mata::nfa::determinize_backward()")
+{
+    // The result is isomorphic to the reverted determinization of the reversal.
+    auto check_determinized_backward = [](const Nfa& aut) {
+        const Nfa result{ determinize_backward(aut) };
+        const Nfa expected{ revert(determinize(revert(aut))) };
+        CHECK(result.num_of_states() == expected.num_of_states());
+        CHECK(result.delta.num_of_transitions() == expected.delta.num_of_transitions());
+        CHECK(result.initial.size() == expected.initial.size());
+        CHECK(result.final.size() == 1);
+        CHECK(revert(result).is_deterministic());
+        CHECK(are_equivalent(result, aut));
+    };
+
+    Nfa aut{ 20 };
+
+    SECTION("empty automaton") {
+        const Nfa result{ determinize_backward(aut) };
+        CHECK(result.num_of_states() == 1);
+        CHECK(result.initial.empty());
+        CHECK(result.final.contains(0));
+        CHECK(result.delta.empty());
+    }
+
+    SECTION("automaton A") {
+        FILL_WITH_AUT_A(aut);
+        check_determinized_backward(aut);
+    }
+
+    SECTION("automaton B") {
+        FILL_WITH_AUT_B(aut);
+        check_determinized_backward(aut);
+    }
+
+    SECTION("initial state is final") {
+        aut.initial = { 0, 1 };
+        aut.final = { 1, 2 };
+        aut.delta.add(0, 'a', 2);
+        aut.delta.add(1, 'a', 2);
+        aut.delta.add(2, 'b', 1);
+        check_determinized_backward(aut);
+    }
+
+    SECTION("random automata") {
+        RandomGenerator random{ 23 };
+        for (size_t i{ 0 }; i < 50; ++i) { check_determinized_backward(random_nfa(random, 3 + i % 8)); }
+    }
+}
+
 TEST_CASE("mata::nfa::Nfa::get_word_from_complement()") {
     Nfa aut{};
     std::optional<mata::Word> result;
@@ -1019,6 +1121,46 @@ TEST_CASE("mata::nfa::minimize() for profiling", "[.profiling],[minimize]") {
     minimize(&result, aut);
 }
 
+TEST_CASE("mata::nfa::minimize() with Moore algorithm") {
+    Nfa aut;
+
+    SECTION("empty automaton") {
+        CHECK(minimize(aut, {{ "algorithm", "moore" }}).num_of_states() == 0);
+    }
+
+    SECTION("equivalent to Brzozowski") {
+        SECTION("automaton A") { FILL_WITH_AUT_A(aut); }
+        SECTION("automaton B") { FILL_WITH_AUT_B(aut); }
+        SECTION("automaton D") { FILL_WITH_AUT_D(aut); }
+        SECTION("automaton E") { FILL_WITH_AUT_E(aut); }
+        SECTION("deterministic automaton with equivalent states") {
+            aut.initial = { 0 };
+            aut.final = { 3, 4 };
+            aut.delta.add(0, 'a', 1);
+            aut.delta.add(0, 'b', 2);
+            aut.delta.add(1, 'a', 3);
+            aut.delta.add(2, 'a', 4);
+            aut.delta.add(3, 'b', 3);
+            aut.delta.add(4, 'b', 4);
+            aut.delta.add(2, 'c', 5);
+        }
+
+        const Nfa expected{ minimize(aut) };
+        const Nfa result{ minimize(aut, {{ "algorithm", "moore" }}) };
+        CHECK(result.is_deterministic());
+        CHECK(result.num_of_states() == expected.num_of_states());
+        CHECK(are_equivalent(result, aut));
+        for (const std::string threads: { "2", "4", "0" }) {
+            CHECK(minimize(aut, {{ "algorithm", "moore" }, { "threads", threads }}).is_identical(result));
+        }
+    }
+
+    SECTION("unknown algorithm") {
+        CHECK_THROWS_WITH(minimize(aut, {{ "algorithm", "unknown" }}),
+                          Catch::Contains("received an unknown value of the \"algo\" key"));
+    }
+}
+
 TEST_CASE("mata::nfa::construct() correct calls")
 { // {{{
     Nfa aut(10);
@@ -1886,6 +2028,54 @@ TEST_CASE("mata::nfa::is_universal()")
     }
 } // }}}
 
+TEST_CASE("mata::nfa::is_universal() over large alphabets")
+{
+    EnumAlphabet alphabet{};
+    for (Symbol symbol{ 0 }; symbol < 100; ++symbol) { alphabet.add_new_symbol(symbol); }
+    Nfa aut(3);
+    aut.initial.insert({ 0, 1 });
+    aut.final.insert({ 0, 1, 2 });
+    for (Symbol symbol{ 0 }; symbol < 100; ++symbol) {
+        if (symbol != 57) { aut.delta.add(0, symbol, 0); }
+        aut.delta.add(1, symbol, 1);
+        if (symbol % 2 == 0) { aut.delta.add(1, symbol, 2); }
+    }
+
+    for (const std::string algorithm: { "naive", "antichains" }) {
+        Run cex;
+        CHECK(aut.is_universal(alphabet, &cex, {{ "algorithm", algorithm }}));
+    }
+
+    // Symbol 57 is used in no initial state now.
+    aut.delta.remove(1, 57, 1);
+    for (const std::string algorithm: { "naive", "antichains" }) {
+        Run cex;
+        CHECK(!aut.is_universal(alphabet, &cex, {{ "algorithm", algorithm }}));
+        CHECK(cex.word == Word{ 57 });
+    }
+
+    RandomGenerator random{ 5 };
+    EnumAlphabet small_alphabet{ 0, 1, 2, 3, 4, 5, 6, 7 };
+    size_t num_of_universal{ 0 };
+    for (size_t i{ 0 }; i < 200; ++i) {
+        Nfa random_aut{ random_nfa(random, 3, 4) };
+        random_aut.initial.insert(random(3));
+        random_aut.final.insert(random(3));
+        // Symbols 4 to 7 copy the transitions of symbols 0 to 3, so they fall into the same symbol classes.
+        const std::vector<Transition> transitions{ random_aut.delta.transitions().begin(),
+                                                   random_aut.delta.transitions().end() };
+        for (const Transition& transition: transitions) {
+            random_aut.delta.add(transition.source, transition.symbol + 4, transition.target);
+        }
+        const bool universal{ random_aut.is_universal(small_alphabet, {{ "algorithm", "naive" }}) };
+        num_of_universal += universal;
+        Run cex;
+        CHECK(random_aut.is_universal(small_alphabet, &cex, {{ "algorithm", "antichains" }}) == universal);
+        if (!universal) { CHECK(!random_aut.is_in_lang(Run{ cex.word, {} })); }
+    }
+    CHECK(num_of_universal > 0);
+}
+
 TEST_CASE("mata::nfa::is_included()")
 { // {{{
     Nfa smaller(10);
@@ -1895,7 +2085,10 @@ TEST_CASE("mata::nfa::is_included()")
 
     const std::unordered_set<std::string> ALGORITHMS = {
         "naive",
+        "naive-lazy",
         "antichains",
+        "antichains-sim",
+        "congruence",
     };
 
     SECTION("{} <= {}, empty alphabet")
@@ -2085,6 +2278,203 @@ TEST_CASE("mata::nfa::is_included()")
     }
 } // }}}
 
+TEST_CASE("mata::nfa::is_included() with simulation subsumption")
+{
+    RandomGenerator random{ 42 };
+    {
+        // An initial state of bigger without transitions which is not final.
+        Nfa smaller{ 2 };
+        smaller.initial.insert(0);
+        smaller.final.insert(1);
+        smaller.delta.add(0, 'a', 1);
+        Nfa bigger{ 1 };
+        bigger.initial.insert(0);
+        Run cex;
+        CHECK(!is_included(smaller, bigger, &cex, nullptr, {{ "algorithm", "antichains-sim" }}));
+        CHECK(cex.word == Word{ 'a' });
+    }
+    {
+        // Length violation: smaller accepts 'ab' while bigger accepts only longer words.
+        Nfa smaller{ 3 };
+        smaller.initial.insert(0);
+        smaller.final.insert(2);
+        smaller.delta.add(0, 'a', 1);
+        smaller.delta.add(1, 'b', 2);
+        Nfa bigger{ 4 };
+        bigger.initial.insert(0);
+        bigger.final.insert(3);
+        bigger.delta.add(0, 'a', 1);
+        bigger.delta.add(1, 'c', 2);
+        bigger.delta.add(2, 'c', 3);
+        Run cex;
+        CHECK(!is_included(smaller, bigger, &cex, nullptr, {{ "algorithm", "antichains-sim" }}));
+        CHECK(cex.word == Word{ 'a', 'b' });
+    }
+
+    for (size_t i{ 0 }; i < 200; ++i) {
+        const Nfa smaller{ random_nfa(random, 4) };
+        const Nfa bigger{ random_nfa(random, 6) };
+        Run sim_cex;
+        const bool included{ is_included(smaller, bigger, &sim_cex, nullptr, {{ "algorithm", "antichains-sim" }}) };
+        if (!included) {
+            CHECK(smaller.is_in_lang(sim_cex));
+            CHECK(!bigger.is_in_lang(sim_cex));
+        }
+        CHECK(included == is_included(smaller, bigger, nullptr, {{ "algorithm", "antichains" }}));
+        CHECK(included == is_included(smaller, bigger, nullptr, {{ "algorithm", "naive" }}));
+        Run cex;
+        CHECK(included == is_included(smaller, bigger, &cex, nullptr, {{ "algorithm", "naive-lazy" }}));
+        if (!included) {
+            CHECK(smaller.is_in_lang(cex));
+            CHECK(!bigger.is_in_lang(cex));
+        }
+        CHECK(are_equivalent(smaller, bigger, {{ "algorithm", "antichains-sim" }})
+              == are_equivalent(smaller, bigger, {{ "algorithm", "antichains" }}));
+    }
+}
+
+TEST_CASE("mata::nfa::is_included() with bisimulation up to congruence")
+{
+    RandomGenerator random{ 7 };
+    for (size_t i{ 0 }; i < 200; ++i) {
+        const Nfa smaller{ random_nfa(random, 4) };
+        const Nfa bigger{ random_nfa(random, 5) };
+        Run cex;
+        const bool included{ is_included(smaller, bigger, &cex, nullptr, {{ "algorithm", "congruence" }}) };
+        CHECK(included == is_included(smaller, bigger, nullptr, {{ "algorithm", "antichains" }}));
+        if (!included) {
+            CHECK(smaller.is_in_lang(cex));
+            CHECK(!bigger.is_in_lang(cex));
+        }
+
+        const bool equivalent{ algorithms::are_equivalent_congruence(smaller, bigger, &cex) };
+        CHECK(equivalent == are_equivalent(smaller, bigger, {{ "algorithm", "antichains" }}));
+        CHECK(equivalent == are_equivalent(smaller, bigger, {{ "algorithm", "congruence" }}));
+        if (!equivalent) { CHECK(smaller.is_in_lang(cex) != bigger.is_in_lang(cex)); }
+    }
+}
+
+TEST_CASE("mata::nfa::is_included() with threads")
+{
+    RandomGenerator random{ 5 };
+    for (size_t i{ 0 }; i < 100; ++i) {
+        const Nfa smaller{ random_nfa(random, 4 + i % 20) };
+        const Nfa bigger{ random_nfa(random, 6 + i % 10) };
+        const bool included{ is_included(smaller, bigger) };
+        Run cex;
+        CHECK(is_included(smaller, bigger, &cex, nullptr, {{ "algorithm", "antichains" }, { "threads", "4" }})
+              == included);
+        if (!included) { CHECK((smaller.is_in_lang(Run{ cex.word, {} }) && !bigger.is_in_lang(Run{ cex.word, {} }))); }
+        CHECK(is_included(smaller, bigger, &cex, nullptr, {{ "algorithm", "antichains" }, { "threads", "1" }})
+              == included);
+        if (!included) { CHECK((smaller.is_in_lang(Run{ cex.word, {} }) && !bigger.is_in_lang(Run{ cex.word, {} }))); }
+    }
+
+    Nfa smaller{ random_nfa(random, 4) };
+    CHECK_THROWS_WITH(is_included(smaller, smaller, nullptr, {{ "algorithm", "antichains" }, { "threads", "x" }}),
+                      Catch::Contains("invalid number of threads"));
+    CHECK_THROWS_WITH(is_included(smaller, smaller, nullptr, {{ "algorithm", "antichains" }, { "threads", "-1" }}),
+                      Catch::Contains("invalid number of threads"));
+    CHECK(mata::utils::parse_num_of_threads("100000") == mata::utils::MAX_NUM_OF_THREADS);
+}
+
+TEST_CASE("mata::nfa::is_included() with exploration orders")
+{
+    RandomGenerator random{ 11 };
+    const std::vector<std::string> EXPLORATIONS{ "dfs", "bfs", "smallest", "distance" };
+    EnumAlphabet alphabet{ 0, 1 };
+    for (size_t i{ 0 }; i < 100; ++i) {
+        const Nfa smaller{ random_nfa(random, 4) };
+        const Nfa bigger{ random_nfa(random, 6) };
+        const bool included{ is_included(smaller, bigger, nullptr, {{ "algorithm", "naive" }}) };
+        const bool universal{ bigger.is_universal(alphabet, {{ "algorithm", "naive" }}) };
+        for (const std::string& exploration: EXPLORATIONS) {
+            CHECK(is_included(smaller, bigger, nullptr, {{ "algorithm", "antichains" }, { "exploration", exploration }})
+                  == included);
+            CHECK(bigger.is_universal(alphabet, {{ "algorithm", "antichains" }, { "exploration", exploration }})
+                  == universal);
+            Run cex;
+            CHECK(is_included(smaller, bigger, &cex, nullptr,
+                              {{ "algorithm", "antichains" }, { "exploration", exploration }, { "threads", "3" }})
+                  == included);
+            if (!included) { CHECK((smaller.is_in_lang(Run{ cex.word, {} }) && !bigger.is_in_lang(Run{ cex.word, {} }))); }
+        }
+    }
+
+    Nfa aut{ random_nfa(random, 4) };
+    CHECK_THROWS_WITH(is_included(aut, aut, nullptr, {{ "algorithm", "antichains" }, { "exploration", "x" }}),
+                      Catch::Contains("unknown exploration order"));
+}
+
+TEST_CASE("mata::nfa::InclusionChecker")
+{
+    RandomGenerator random{ 3 };
+    const Nfa bigger{ random_nfa(random, 6) };
+    std::vector<Nfa> smaller;
+    for (size_t i{ 0 }; i < 100; ++i) { smaller.push_back(random_nfa(random, 4)); }
+    std::vector<const Nfa*> smaller_ptrs;
+    for (const Nfa& aut: smaller) { smaller_ptrs.push_back(&aut); }
+    std::vector<bool> expected;
+    for (const Nfa& aut: smaller) { expected.push_back(is_included(aut, bigger)); }
+    CHECK(std::count(expected.begin(), expected.end(), true) > 0);
+    CHECK(std::count(expected.begin(), expected.end(), false) > 0);
+
+    for (const std::string algorithm: { "naive", "antichains", "antichains-sim" }) {
+        InclusionChecker checker{ bigger, {{ "algorithm", algorithm }} };
+        for (size_t i{ 0 }; i < smaller.size(); ++i) {
+            Run cex;
+            CHECK(checker.check(smaller[i]) == expected[i]);
+            CHECK(checker.check(smaller[i], &cex) == expected[i]);
+            if (!expected[i]) {
+                CHECK(smaller[i].is_in_lang(cex));
+                CHECK(!bigger.is_in_lang(cex));
+            }
+        }
+
+        std::vector<Run> cexs;
+        CHECK(checker.check_all(smaller_ptrs, 3, &cexs) == expected);
+        for (size_t i{ 0 }; i < smaller.size(); ++i) {
+            if (!expected[i]) {
+                CHECK(smaller[i].is_in_lang(cexs[i]));
+                CHECK(!bigger.is_in_lang(cexs[i]));
+            }
+        }
+    }
+
+    CHECK_THROWS_WITH(InclusionChecker(bigger, {{ "algorithm", "foo" }}), Catch::Contains("unknown value"));
+}
+
+TEST_CASE("mata::nfa::are_equivalent() of deterministic automata")
+{
+    RandomGenerator random{ 9 };
+    auto random_dfa = [&](const size_t num_of_states) {
+        Nfa aut{ random_nfa(random, num_of_states) };
+        aut.initial = { 0 };
+        return minimize(determinize(aut));
+    };
+
+    size_t num_of_equivalent{ 0 };
+    for (size_t i{ 0 }; i < 200; ++i) {
+        const Nfa lhs{ random_dfa(3) };
+        const Nfa rhs{ random_dfa(3) };
+        REQUIRE(lhs.is_deterministic());
+        REQUIRE(rhs.is_deterministic());
+        const bool equivalent{ are_equivalent(lhs, rhs, {{ "algorithm", "congruence" }}) };
+        if (equivalent) { ++num_of_equivalent; }
+        Run cex;
+        CHECK(algorithms::are_equivalent_hopcroft_karp(lhs, rhs, &cex) == equivalent);
+        if (!equivalent) { CHECK(lhs.is_in_lang(cex) != rhs.is_in_lang(cex)); }
+        CHECK(are_equivalent(lhs, rhs) == equivalent);
+        CHECK(are_equivalent(lhs, rhs, {{ "algorithm", "hopcroft-karp" }}) == equivalent);
+    }
+    CHECK(num_of_equivalent > 0);
+
+    Nfa nondeterministic(2);
+    nondeterministic.initial = { 0, 1 };
+    CHECK_THROWS_WITH(are_equivalent(nondeterministic, nondeterministic, {{ "algorithm", "hopcroft-karp" }}),
+                      Catch::Contains("requires deterministic automata"));
+}
+
 TEST_CASE("mata::nfa::are_equivalent")
 {
     Nfa smaller(10);
@@ -2094,7 +2484,10 @@ TEST_CASE("mata::nfa::are_equivalent")
 
     const std::unordered_set<std::string> ALGORITHMS = {
             "naive",
+            "naive-lazy",
             "antichains",
+            "antichains-sim",
+            "congruence",
     };
 
     SECTION("{} == {}, empty alphabet")
@@ -2372,6 +2765,26 @@ TEST_CASE("mata::nfa::revert()")
         CHECK(res.delta.contains(12, 'b', 14));
         CHECK(res.delta.contains(14, 'a', 12));
     }
+
+    SECTION("Large symbols and threads") {
+        RandomGenerator random{ 19 };
+        const std::vector<Symbol> symbols{ 0, 7, 1000000, EPSILON - 1, EPSILON };
+        Nfa nfa{ 50 };
+        nfa.initial.insert({ 0, 1 });
+        nfa.final.insert(49);
+        for (size_t i{ 0 }; i < 300; ++i) { nfa.delta.add(random(50), symbols[random(symbols.size())], random(50)); }
+
+        for (const size_t num_of_threads: { size_t{ 1 }, size_t{ 3 }, size_t{ 8 } }) {
+            const Nfa res{ revert(nfa, num_of_threads) };
+            CHECK(res.initial == nfa.final);
+            CHECK(res.final == nfa.initial);
+            CHECK(res.delta.num_of_transitions() == nfa.delta.num_of_transitions());
+            for (const Transition& trans: nfa.delta.transitions()) {
+                CHECK(res.delta.contains(trans.target, trans.symbol, trans.source));
+            }
+            CHECK(revert(res, num_of_threads).delta == nfa.delta);
+        }
+    }
 } // }}}
 
 
@@ -2550,6 +2963,42 @@ TEST_CASE("mata::nfa::is_prfx_in_lang()")
     }
 } // }}}
 
+TEST_CASE("mata::nfa::is_in_lang() with epsilon transitions")
+{
+    RandomGenerator random{ 17 };
+
+    std::vector<Word> words{ {} };
+    for (size_t i{ 0 }; i < words.size() && words[i].size() < 4; ++i) {
+        for (const Symbol symbol: { Symbol{ 0 }, Symbol{ 1 } }) {
+            Word word{ words[i] };
+            word.push_back(symbol);
+            words.push_back(word);
+        }
+    }
+
+    for (size_t i{ 0 }; i < 50; ++i) {
+        const size_t num_of_states{ 3 + i % 8 };
+        Nfa aut(num_of_states);
+        aut.initial.insert(random(num_of_states));
+        aut.final.insert(random(num_of_states));
+        for (size_t j{ 0 }; j < num_of_states * 3; ++j) {
+            const Symbol symbol{ random(3) == 2 ? EPSILON : static_cast<Symbol>(random(2)) };
+            aut.delta.add(random(num_of_states), symbol, random(num_of_states));
+        }
+
+        const Nfa without_epsilon{ remove_epsilon(aut) };
+        EpsilonClosures closures{ aut };
+        for (const Word& word: words) {
+            const bool in_lang{ without_epsilon.is_in_lang(Run{ word, {} }) };
+            CHECK(aut.is_in_lang(Run{ word, {} }) == in_lang);
+            CHECK(closures.is_in_lang(word) == in_lang);
+            CHECK(aut.is_prfx_in_lang(Run{ word, {} }) == without_epsilon.is_prfx_in_lang(Run{ word, {} }));
+        }
+        CHECK(aut.post(closures.closure(StateSet{ aut.initial }), 0)
+              == closures.closure(without_epsilon.post(StateSet{ aut.initial }, 0)));
+    }
+}
+
 TEST_CASE("mata::nfa::fw-direct-simulation()")
 { // {{{
     Nfa aut;
@@ -2629,6 +3078,144 @@ TEST_CASE("mata::nfa::fw-direct-simulation()")
     }
 } // }}
 
+TEST_CASE("mata::nfa::compute_partition_relation()")
+{ // {{{
+    Nfa aut;
+
+    SECTION("empty automaton")
+    {
+        Simlib::Util::PartitionRelation result = compute_partition_relation(aut);
+
+        REQUIRE(result.size() == 0);
+        REQUIRE(result.blocks() == 0);
+    }
+
+    SECTION("no-transition automaton")
+    {
+        aut.add_state(8);
+        aut.initial = { 1, 3 };
+        aut.final = { 2, 5 };
+
+        Simlib::Util::PartitionRelation result = compute_partition_relation(aut);
+        REQUIRE(result.size() == 9);
+        REQUIRE(result.blocks() == 2);
+        REQUIRE(result.sym(1, 3));
+        REQUIRE(result.sym(2, 5));
+        REQUIRE(result.get(1, 5));
+        REQUIRE(!result.get(5, 1));
+        std::vector<size_t> quot_proj;
+        result.get_quotient_projection(quot_proj);
+        CHECK(quot_proj == std::vector<size_t>{ 0, 0, 2, 0, 0, 2, 0, 0, 0 });
+    }
+
+    SECTION("matches the dense relation")
+    {
+        Nfa aut_big(9);
+        aut_big.initial = {1, 2};
+        aut_big.delta.add(1, 'a', 2);
+        aut_big.delta.add(1, 'a', 3);
+        aut_big.delta.add(1, 'b', 4);
+        aut_big.delta.add(2, 'a', 2);
+        aut_big.delta.add(2, 'b', 2);
+        aut_big.delta.add(2, 'a', 3);
+        aut_big.delta.add(2, 'b', 4);
+        aut_big.delta.add(3, 'b', 4);
+        aut_big.delta.add(3, 'c', 7);
+        aut_big.delta.add(3, 'b', 2);
+        aut_big.delta.add(5, 'c', 3);
+        aut_big.delta.add(7, 'a', 8);
+        aut_big.final = {3};
+
+        const Simlib::Util::BinaryRelation dense = compute_relation(aut_big);
+        const Simlib::Util::PartitionRelation compressed = compute_partition_relation(aut_big);
+        CHECK(compressed == Simlib::Util::PartitionRelation(dense));
+        for (State p = 0; p < aut_big.num_of_states(); ++p) {
+            for (State q = 0; q < aut_big.num_of_states(); ++q) {
+                CHECK(compressed.get(p, q) == dense.get(p, q));
+            }
+        }
+
+        Simlib::Util::BinaryRelation expanded;
+        compressed.build_binary_relation(expanded);
+        CHECK(expanded.size() == dense.size());
+        for (State p = 0; p < aut_big.num_of_states(); ++p) {
+            for (State q = 0; q < aut_big.num_of_states(); ++q) {
+                CHECK(expanded.get(p, q) == dense.get(p, q));
+            }
+        }
+    }
+} // }}}
+
+TEST_CASE("mata::nfa::compute_partition_relation() with threads")
+{ // {{{
+    Nfa aut;
+
+    SECTION("empty automaton")
+    {
+        CHECK(compute_partition_relation(aut, {{ "relation", "simulation" }, { "direction", "forward" },
+                                               { "threads", "2" }}).size() == 0);
+        CHECK(compute_relation(aut, {{ "relation", "simulation" }, { "direction", "forward" },
+                                     { "threads", "2" }}).size() == 0);
+    }
+
+    SECTION("invalid number of threads")
+    {
+        aut.add_state(1);
+        CHECK_THROWS_AS(compute_partition_relation(aut, {{ "relation", "simulation" }, { "direction", "forward" },
+                                                         { "threads", "two" }}), std::runtime_error);
+    }
+
+    SECTION("matches the sequential relation")
+    {
+        SECTION("automaton A") { FILL_WITH_AUT_A(aut); }
+        SECTION("automaton B") { FILL_WITH_AUT_B(aut); }
+        SECTION("automaton D") { FILL_WITH_AUT_D(aut); }
+        SECTION("automaton E") { FILL_WITH_AUT_E(aut); }
+        SECTION("only final states")
+        {
+            aut.add_state(3);
+            aut.final = { 0, 1, 2, 3 };
+            aut.delta.add(0, 'a', 1);
+            aut.delta.add(2, 'a', 3);
+            aut.delta.add(3, 'b', 3);
+        }
+        SECTION("generated automaton")
+        {
+            const State num_of_states{ 200 };
+            aut.add_state(num_of_states - 1);
+            for (State state{ 0 }; state < num_of_states; ++state) {
+                aut.delta.add(state, static_cast<Symbol>(state % 3), (state * 7 + 1) % num_of_states);
+                aut.delta.add(state, static_cast<Symbol>((state / 3) % 2), (state * 13 + 5) % num_of_states);
+                if (state % 5 == 0) { aut.delta.add(state, EPSILON, (state + 1) % num_of_states); }
+                if (state % 11 == 0) { aut.final.insert(state); }
+            }
+            aut.initial = { 0 };
+        }
+
+        const Simlib::Util::PartitionRelation sequential{ compute_partition_relation(aut) };
+        for (const std::string threads: { "1", "2", "4", "0" }) {
+            CHECK(compute_partition_relation(aut, {{ "relation", "simulation" }, { "direction", "forward" },
+                                                   { "threads", threads }}) == sequential);
+        }
+        const Simlib::Util::BinaryRelation dense{ compute_relation(aut) };
+        const Simlib::Util::BinaryRelation dense_parallel{
+            compute_relation(aut, {{ "relation", "simulation" }, { "direction", "forward" }, { "threads", "3" }}) };
+        REQUIRE(dense_parallel.size() == dense.size());
+        for (State p = 0; p < dense.size(); ++p) {
+            for (State q = 0; q < dense.size(); ++q) {
+                CHECK(dense_parallel.get(p, q) == dense.get(p, q));
+            }
+        }
+
+        StateRenaming renaming;
+        StateRenaming renaming_parallel;
+        const Nfa reduced{ reduce(aut, &renaming) };
+        const Nfa reduced_parallel{ reduce(aut, &renaming_parallel, {{ "algorithm", "simulation" }, { "threads", "2" }}) };
+        CHECK(renaming_parallel == renaming);
+        CHECK(reduced_parallel.is_identical(reduced));
+    }
+} // }}}
+
 TEST_CASE("mata::nfa::reduce_size_by_simulation()")
 {
     Nfa aut;
@@ -2997,6 +3584,34 @@ TEST_CASE("mata::nfa::reduce_size_by_residual()") {
 
     }
 
+    SECTION("generated automaton with many covered macrostates")
+    {
+        const State num_of_states{ 24 };
+        aut.add_state(num_of_states - 1);
+        for (State state{ 0 }; state < num_of_states; ++state) {
+            aut.delta.add(state, 'a', (state * 5 + 1) % num_of_states);
+            aut.delta.add(state, 'a', (state * 7 + 3) % num_of_states);
+            aut.delta.add(state, 'b', (state * 11 + 2) % num_of_states);
+            if (state % 4 == 0) { aut.delta.add(state, 'b', (state + 1) % num_of_states); }
+            if (state % 3 == 0) { aut.final.insert(state); }
+        }
+        aut.initial = { 0, 5 };
+
+        for (const std::string direction: { "forward", "backward" }) {
+            params_after["type"] = "after";
+            params_after["direction"] = direction;
+            params_with["type"] = "with";
+            params_with["direction"] = direction;
+
+            Nfa result_after = reduce(aut, &state_renaming, params_after);
+            Nfa result_with = reduce(aut, &state_renaming, params_with);
+
+            CHECK(result_after.num_of_states() == result_with.num_of_states());
+            CHECK(are_equivalent(aut, result_after));
+            CHECK(are_equivalent(aut, result_with));
+        }
+    }
+
     SECTION("error checking")
     {
         CHECK_THROWS_WITH(reduce(aut, &state_renaming, params_after),
@@ -3216,6 +3831,61 @@ TEST_CASE("mata::nfa::remove_epsilon()")
     REQUIRE(aut.delta.contains(5, 'a', 9));
 }
 
+TEST_CASE("mata::nfa::remove_epsilon() with epsilon cycles")
+{
+    RandomGenerator random{ 13 };
+
+    // Check that @p result is @p aut with transitions over @p epsilons removed, by computing closures by a plain search.
+    auto check_removed = [](const Nfa& aut, const Nfa& result, const OrdVector<Symbol>& epsilons) {
+        const size_t num_of_states{ aut.num_of_states() };
+        for (State state{ 0 }; state < num_of_states; ++state) {
+            std::vector<bool> in_closure(num_of_states, false);
+            std::vector<State> worklist{ state };
+            in_closure[state] = true;
+            while (!worklist.empty()) {
+                const State current{ worklist.back() };
+                worklist.pop_back();
+                for (const SymbolPost& symbol_post: aut.delta[current]) {
+                    if (!epsilons.contains(symbol_post.symbol)) { continue; }
+                    for (const State target: symbol_post.targets) {
+                        if (!in_closure[target]) {
+                            in_closure[target] = true;
+                            worklist.push_back(target);
+                        }
+                    }
+                }
+            }
+
+            bool is_final{ false };
+            for (State closure_state{ 0 }; closure_state < num_of_states; ++closure_state) {
+                if (in_closure[closure_state] && aut.final.contains(closure_state)) { is_final = true; }
+            }
+            CHECK(result.final.contains(state) == is_final);
+            for (Symbol symbol{ 0 }; symbol < 4; ++symbol) {
+                for (State target{ 0 }; target < num_of_states; ++target) {
+                    bool expected{ false };
+                    for (State closure_state{ 0 }; closure_state < num_of_states; ++closure_state) {
+                        if (in_closure[closure_state] && aut.delta.contains(closure_state, symbol, target)) {
+                            expected = !epsilons.contains(symbol);
+                        }
+                    }
+                    CHECK(result.delta.contains(state, symbol, target) == expected);
+                }
+            }
+        }
+    };
+
+    for (size_t i{ 0 }; i < 50; ++i) {
+        const Nfa aut{ random_nfa(random, 3 + i % 10, 4) };
+
+        check_removed(aut, remove_epsilon(aut, 2), { 2 });
+        const Nfa result{ remove_epsilon(aut, OrdVector<Symbol>{ 2, 3 }) };
+        check_removed(aut, result, { 2, 3 });
+        CHECK(remove_epsilon(aut, 2, 3).delta == result.delta);
+        check_removed(aut, remove_epsilon(aut, OrdVector<Symbol>{ 1, 3 }), { 1, 3 });
+    }
+}
+
 TEST_CASE("Profile mata::nfa::remove_epsilon()", "[.profiling]")
 {
     for (size_t n{}; n < 100000; ++n) {
@@ -3803,6 +4473,139 @@ TEST_CASE("mata::nfa::get_useful_states_tarjan") {
     }
 }
 
+TEST_CASE("mata::nfa::Nfa cached distances and useful states") {
+    Nfa aut(5, { 0 }, { 3 });
+    aut.delta.add(0, 'a', 1);
+    aut.delta.add(1, 'b', 2);
+    aut.delta.add(2, 'a', 3);
+    aut.delta.add(0, 'c', 4);
+
+    CHECK(aut.distances_from_initial() == std::vector<State>{ 0, 1, 2, 3, 1, Limits::max_state });
+    CHECK(aut.distances_to_final() == std::vector<State>{ 3, 2, 1, 0, Limits::max_state, Limits::max_state });
+    CHECK(aut.distances_to_final() == revert(aut).distances_from_initial());
+    CHECK(aut.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 0 });
+    CHECK(aut.get_condensation().num_of_sccs() == 5);
+
+    SECTION("modified delta") {
+        aut.delta.add(4, 'a', 3);
+        aut.delta.add(3, 'a', 0);
+        CHECK(aut.distances_to_final() == std::vector<State>{ 2, 2, 1, 0, 1, Limits::max_state });
+        CHECK(aut.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 1 });
+        CHECK(aut.get_condensation().num_of_sccs() == 1);
+        aut.delta.remove(3, 'a', 0);
+        CHECK(aut.get_condensation().num_of_sccs() == 5);
+    }
+
+    SECTION("modified through a held reference") {
+        StatePost& state_post{ aut.delta.mutable_state_post(4) };
+        CHECK(aut.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 0 });
+        state_post.insert(SymbolPost{ 'a', StateSet{ 3 } });
+        CHECK(aut.distances_to_final() == std::vector<State>{ 2, 2, 1, 0, 1, Limits::max_state });
+        CHECK(aut.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 1 });
+        state_post.begin()->targets.insert(0);
+        CHECK(aut.get_condensation().num_of_sccs() == 4);
+        aut.delta.release_mutable_references();
+        CHECK(aut.get_condensation().num_of_sccs() == 4);
+    }
+
+    SECTION("modified initial and final states") {
+        aut.final.insert(4);
+        CHECK(aut.distances_to_final()[0] == 1);
+        CHECK(aut.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 1 });
+        aut.initial = { 2 };
+        CHECK(aut.distances_from_initial() == std::vector<State>{
+            Limits::max_state, Limits::max_state, 0, 1, Limits::max_state, Limits::max_state });
+        aut.final.insert(6);
+        CHECK(aut.distances_to_final().size() == 8);
+    }
+
+    SECTION("copies and assignments") {
+        Nfa copy{ aut };
+        copy.delta.add(4, 'a', 3);
+        CHECK(copy.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 1 });
+        CHECK(aut.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 0 });
+        aut = copy;
+        CHECK(aut.get_useful_states() == mata::BoolVector{ 1, 1, 1, 1, 1 });
+        aut = Nfa(2, { 0 }, { 1 });
+        CHECK(aut.get_useful_states() == mata::BoolVector{ 0, 0 });
+        CHECK(aut.distances_to_final() == std::vector<State>{ Limits::max_state, 0, Limits::max_state });
+    }
+
+    SECTION("shared by several threads") {
+        const Nfa shared{ aut };
+        std::vector<std::vector<State>> distances(8);
+        std::vector<mata::BoolVector> useful_states(8);
+        std::vector<size_t> num_of_sccs(8);
+        // Catch assertions are not thread-safe, the results are checked after the threads finish.
+        mata::utils::parallel_for(8, 4, [&](const size_t index, const size_t) {
+            distances[index] = shared.distances_to_final();
+            useful_states[index] = shared.get_useful_states();
+            num_of_sccs[index] = shared.get_condensation().num_of_sccs();
+        });
+        for (size_t index{ 0 }; index < 8; ++index) {
+            CHECK(distances[index] == aut.distances_to_final());
+            CHECK(useful_states[index] == aut.get_useful_states());
+            CHECK(num_of_sccs[index] == 5);
+        }
+    }
+}
+
+TEST_CASE("mata::nfa::get_useful_states() with threads") {
+    RandomGenerator random{ 7 };
+    // States are spread over several bitset words, and the transitions have at most 'max_distance' in between.
+    auto random_banded_nfa = [&](const size_t num_of_states, const size_t max_distance) {
+        Nfa aut(num_of_states);
+        for (size_t i{ 0 }; i < 3; ++i) {
+            aut.initial.insert(random(num_of_states));
+            aut.final.insert(random(num_of_states));
+        }
+        for (size_t i{ 0 }; i < num_of_states * 2; ++i) {
+            const State source{ random(num_of_states) };
+            const State target{ std::min(num_of_states - 1, source + random(max_distance)) };
+            aut.delta.add(random(2) ? source : target, static_cast<Symbol>(random(3)), random(2) ? target : source);
+        }
+        return aut;
+    };
+    // Plain search over @p aut, collecting states reachable from @p sources.
+    auto search = [](const Nfa& aut, const mata::utils::SparseSet<State>& sources) {
+        std::vector<bool> visited(aut.num_of_states(), false);
+        std::vector<State> stack{ sources.begin(), sources.end() };
+        for (const State state: sources) { visited[state] = true; }
+        while (!stack.empty()) {
+            const State state{ stack.back() };
+            stack.pop_back();
+            for (const Move& move: aut.delta[state].moves()) {
+                if (!visited[move.target]) {
+                    visited[move.target] = true;
+                    stack.push_back(move.target);
+                }
+            }
+        }
+        StateSet result;
+        for (State state{ 0 }; state < aut.num_of_states(); ++state) { if (visited[state]) { result.insert(state); } }
+        return result;
+    };
+
+    for (size_t i{ 0 }; i < 50; ++i) {
+        Nfa aut{ random_banded_nfa(10 + random(300), 1 + random(70)) };
+        const StateSet reachable{ search(aut, aut.initial) };
+        const Nfa reverted{ revert(aut) };
+        const StateSet terminating{ search(reverted, aut.final) };
+        mata::BoolVector useful(aut.num_of_states(), false);
+        for (const State state: reachable) { useful[state] = terminating.contains(state); }
+
+        for (const size_t num_of_threads: { size_t{ 1 }, size_t{ 4 } }) {
+            CHECK(aut.get_reachable_states(num_of_threads) == reachable);
+            CHECK(aut.get_terminating_states(num_of_threads) == terminating);
+            CHECK(aut.get_useful_states(num_of_threads) == useful);
+            Nfa trimmed{ aut };
+            trimmed.trim(nullptr, num_of_threads);
+            CHECK(trimmed.num_of_states() == useful.count());
+            CHECK(are_equivalent(trimmed, aut));
+        }
+    }
+}
+
 TEST_CASE("mata::nfa::Nfa::get_words") {
     SECTION("empty") {
         Nfa aut;
@@ -3952,3 +4755,50 @@ TEST_CASE("mata::nfa::Nfa::get_word()") {
         CHECK(aut.get_word() == Word{ 1 });
     }
 }
+
+TEST_CASE("mata::nfa::Traversal") {
+    Nfa aut(7, { 0 }, { 5 });
+    aut.delta.add(0, 'a', 1);
+    aut.delta.add(0, 'b', 2);
+    aut.delta.add(1, 'c', 3);
+    aut.delta.add(2, EPSILON, 3);
+    aut.delta.add(3, 'a', 4);
+    aut.delta.add(4, EPSILON, 5);
+    aut.delta.add(6, 'a', 0);
+
+    SECTION("BFS") {
+        Traversal traversal{};
+        CHECK(traversal.run(aut, aut.initial, [&](const State state) { return aut.final.contains(state); }) == 5);
+        CHECK(traversal.path_to(5) == std::vector<State>{ 0, 1, 3, 4, 5 });
+        CHECK(traversal.word_to(5) == Word{ 'a', 'c', 'a' });
+        CHECK(traversal.depth(5) == 4);
+        CHECK(traversal.parent(0) == Traversal::NO_PARENT);
+        CHECK(traversal.parent_symbol(2) == 'b');
+        CHECK(!traversal.is_visited(6));
+
+        // The traversal is reused for another search.
+        traversal.run(aut, StateSet{ 2 });
+        CHECK(traversal.visited_states() == std::vector<State>{ 2, 3, 4, 5 });
+        CHECK(!traversal.is_visited(0));
+        CHECK(traversal.path_to(5) == std::vector<State>{ 2, 3, 4, 5 });
+        CHECK(traversal.word_to(5) == Word{ 'a' });
+
+        CHECK(traversal.run(aut, StateSet{ 6 }, [](const State state) { return state == 7; }) == std::nullopt);
+        CHECK(traversal.visited_states().size() == 7);
+    }
+
+    SECTION("DFS") {
+        Traversal traversal{ Traversal::Order::DFS };
+        traversal.run(aut, aut.initial);
+        // States discovered from 2 are searched first.
+        CHECK(traversal.visited_states() == std::vector<State>{ 0, 1, 2, 3, 4, 5 });
+        CHECK(traversal.path_to(4) == std::vector<State>{ 0, 2, 3, 4 });
+        CHECK(traversal.word_to(4) == Word{ 'b', 'a' });
+    }
+
+    SECTION("epsilon symbols") {
+        Traversal traversal{ Traversal::Order::BFS, 'c' };
+        traversal.run(aut, aut.initial);
+        CHECK(traversal.word_to(5) == Word{ 'a', 'a' });
+    }
+}
@@ -1,3 +1,8 @@
+#ifndef MATA_TESTS_NFA_UTILS_HH_
+#define MATA_TESTS_NFA_UTILS_HH_
+
+#include "mata/nfa/nfa.hh"
+
 // Automaton A
 #define FILL_WITH_AUT_A(x) \
     x.initial = {1, 3}; \
@@ -96,3 +101,36 @@
 	x.delta.add(2, 'a', 4); \
 	x.delta.add(1, 'a', 3); \
 
+/// Seeded pseudo-random generator (a 64-bit linear congruential generator) for reproducible randomized tests.
+class RandomGenerator {
+public:
+    explicit RandomGenerator(const size_t seed): seed_{ seed } {}
+
+    /// Get the next 64-bit state of the generator.
+    size_t next() {
+        seed_ = seed_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        return seed_;
+    }
+
+    /// Get a pseudo-random number from 0 to @p bound - 1.
+    size_t operator()(const size_t bound) { return (next() >> 33) % bound; }
+
+private:
+    size_t seed_;
+};
+
+/**
+ * Random automaton with @p num_of_states states, a single initial and a single final state, and
+ *  'num_of_states * 3' transitions over the symbols 0, ..., @p num_of_symbols - 1.
+ */
+inline mata::nfa::Nfa random_nfa(RandomGenerator& random, const size_t num_of_states, const size_t num_of_symbols = 2) {
+    mata::nfa::Nfa aut(num_of_states);
+    aut.initial.insert(random(num_of_states));
+    aut.final.insert(random(num_of_states));
+    for (size_t i{ 0 }; i < num_of_states * 3; ++i) {
+        aut.delta.add(random(num_of_states), static_cast<mata::Symbol>(random(num_of_symbols)), random(num_of_states));
+    }
+    return aut;
+}
+
+#endif // MATA_TESTS_NFA_UTILS_HH_
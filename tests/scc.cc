@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+
+#include "mata/utils/scc.hh"
+
+#include <algorithm>
+#include <ranges>
+
+using namespace mata::utils;
+
+namespace {
+    using Graph = std::vector<std::vector<size_t>>;
+
+    auto successors_of(const Graph& graph) {
+        return [&graph](const size_t vertex) -> const std::vector<size_t>& { return graph[vertex]; };
+    }
+
+    std::vector<size_t> sorted(const std::span<const size_t> vertices) {
+        std::vector<size_t> result{ vertices.begin(), vertices.end() };
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST_CASE("mata::utils::tarjan_scc()") {
+    // SCCs {0, 1, 2}, {3}, {4, 5}, {6} (with a self-loop) and an unreachable {7}.
+    const Graph graph{ { 1 }, { 2, 3 }, { 0, 4 }, { 5 }, { 5 }, { 4, 6 }, { 6 }, { 0 } };
+    const std::vector<size_t> roots{ 0 };
+
+    SECTION("SCCs are completed in a reverse topological order") {
+        struct Visitor : SccVisitor<size_t> {
+            std::vector<std::vector<size_t>> sccs{};
+            size_t num_of_edges{ 0 };
+            void examine_edge(size_t, size_t) { ++num_of_edges; }
+            bool finish_scc(const std::span<const size_t> scc) {
+                sccs.push_back(sorted(scc));
+                return false;
+            }
+        } visitor{};
+        CHECK(!tarjan_scc(graph.size(), roots, successors_of(graph), visitor));
+        CHECK(visitor.sccs == std::vector<std::vector<size_t>>{ { 6 }, { 4, 5 }, { 3 }, { 0, 1, 2 } });
+        CHECK(visitor.num_of_edges == 10);
+    }
+
+    SECTION("the visitor stops the traversal") {
+        struct Visitor : SccVisitor<size_t> {
+            std::vector<size_t> discovered{};
+            bool discover_vertex(const size_t vertex) {
+                discovered.push_back(vertex);
+                return vertex == 4;
+            }
+        } visitor{};
+        CHECK(tarjan_scc(graph.size(), roots, successors_of(graph), visitor));
+        CHECK(visitor.discovered.back() == 4);
+        CHECK(std::find(visitor.discovered.begin(), visitor.discovered.end(), 6) == visitor.discovered.end());
+    }
+
+    SECTION("condensation") {
+        const Condensation<size_t> condensation{ compute_condensation(graph.size(), roots, successors_of(graph)) };
+        REQUIRE(condensation.num_of_sccs() == 4);
+        CHECK(sorted(condensation.scc(0)) == std::vector<size_t>{ 0, 1, 2 });
+        CHECK(sorted(condensation.scc(1)) == std::vector<size_t>{ 3 });
+        CHECK(sorted(condensation.scc(2)) == std::vector<size_t>{ 4, 5 });
+        CHECK(sorted(condensation.scc(3)) == std::vector<size_t>{ 6 });
+        CHECK(condensation.scc_of[1] == 0);
+        CHECK(condensation.scc_of[5] == 2);
+        CHECK(condensation.scc_of[7] == Condensation<size_t>::NO_SCC);
+        CHECK(sorted(condensation.scc_successors(0)) == std::vector<size_t>{ 1, 2 });
+        CHECK(sorted(condensation.scc_successors(1)) == std::vector<size_t>{ 2 });
+        CHECK(sorted(condensation.scc_successors(2)) == std::vector<size_t>{ 3 });
+        CHECK(condensation.scc_successors(3).empty());
+        CHECK(condensation.cyclic == std::vector<bool>{ true, false, true, true });
+    }
+
+    SECTION("condensation of the whole graph") {
+        const Condensation<size_t> condensation{
+            compute_condensation(graph.size(), std::views::iota(size_t{ 0 }, graph.size()), successors_of(graph)) };
+        REQUIRE(condensation.num_of_sccs() == 5);
+        CHECK(sorted(condensation.scc(0)) == std::vector<size_t>{ 7 });
+        CHECK(condensation.scc_successors(0).size() == 1);
+        CHECK(condensation.scc_of[0] == condensation.scc_successors(0)[0]);
+        for (size_t scc{ 0 }; scc < condensation.num_of_sccs(); ++scc) {
+            for (const size_t target: condensation.scc_successors(scc)) { CHECK(scc < target); }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+
+#include "mata/utils/set-trie.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::utils;
+using namespace mata::nfa;
+
+namespace {
+    template<class Query>
+    std::vector<size_t> collect(const SetTrie<State, size_t>& trie, const Query& query) {
+        std::vector<size_t> result;
+        query(trie, [&](const size_t value) { result.push_back(value); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST_CASE("mata::utils::SetTrie") {
+    SetTrie<State, size_t> trie;
+    const std::vector<StateSet> sets{ {}, { 1 }, { 1, 2 }, { 2, 3 }, { 1, 2, 3 }, { 0, 2, 4 }, { 3 } };
+    for (size_t i{ 0 }; i < sets.size(); ++i) { CHECK(trie.insert(sets[i], i)); }
+
+    SECTION("insert, find, erase") {
+        CHECK(trie.size() == sets.size());
+        CHECK(!trie.insert(sets[2], 42));
+        CHECK(trie.size() == sets.size());
+        REQUIRE(trie.find(sets[2]) != nullptr);
+        CHECK(*trie.find(sets[2]) == 42);
+        CHECK(trie.find({ 2 }) == nullptr);
+        CHECK(trie.find({ 1, 2, 3, 4 }) == nullptr);
+        CHECK(trie.erase({ 1, 2 }));
+        CHECK(!trie.erase({ 1, 2 }));
+        CHECK(!trie.contains({ 1, 2 }));
+        CHECK(trie.contains({ 1, 2, 3 }));
+        CHECK(trie.size() == sets.size() - 1);
+        trie.clear();
+        CHECK(trie.empty());
+        CHECK(!trie.contains({}));
+    }
+
+    SECTION("subsets") {
+        auto subsets_of = [](const StateSet& set) {
+            return [set](const SetTrie<State, size_t>& t, auto&& func) { t.for_each_subset_of(set, func); };
+        };
+        CHECK(collect(trie, subsets_of({ 1, 2, 3 })) == std::vector<size_t>{ 0, 1, 2, 3, 4, 6 });
+        CHECK(collect(trie, subsets_of({ 0, 2, 3, 4 })) == std::vector<size_t>{ 0, 3, 5, 6 });
+        CHECK(collect(trie, subsets_of({})) == std::vector<size_t>{ 0 });
+        trie.erase({});
+        CHECK(collect(trie, subsets_of({ 5, 6 })).empty());
+        CHECK(!trie.contains_subset_of({ 2, 4 }));
+        CHECK(trie.contains_subset_of({ 2, 3, 4 }));
+    }
+
+    SECTION("supersets") {
+        auto supersets_of = [](const StateSet& set) {
+            return [set](const SetTrie<State, size_t>& t, auto&& func) { t.for_each_superset_of(set, func); };
+        };
+        CHECK(collect(trie, supersets_of({ 2 })) == std::vector<size_t>{ 2, 3, 4, 5 });
+        CHECK(collect(trie, supersets_of({ 3 })) == std::vector<size_t>{ 3, 4, 6 });
+        CHECK(collect(trie, supersets_of({ 1, 3 })) == std::vector<size_t>{ 4 });
+        CHECK(collect(trie, supersets_of({})) == std::vector<size_t>{ 0, 1, 2, 3, 4, 5, 6 });
+        CHECK(collect(trie, supersets_of({ 5 })).empty());
+    }
+
+    SECTION("matches naive subset checks") {
+        std::vector<StateSet> all_sets;
+        SetTrie<State, size_t> index;
+        for (State i{ 0 }; i < 64; ++i) {
+            StateSet set;
+            for (State bit{ 0 }; bit < 6; ++bit) { if ((i * 37 + 11) & (State{ 1 } << bit)) { set.insert(bit); } }
+            if (index.insert(set, all_sets.size())) { all_sets.push_back(set); }
+        }
+        for (const StateSet& query: all_sets) {
+            std::vector<size_t> expected_subsets, expected_supersets;
+            for (size_t i{ 0 }; i < all_sets.size(); ++i) {
+                if (all_sets[i].is_subset_of(query)) { expected_subsets.push_back(i); }
+                if (query.is_subset_of(all_sets[i])) { expected_supersets.push_back(i); }
+            }
+            std::vector<size_t> subsets, supersets;
+            index.for_each_subset_of(query, [&](const size_t value) { subsets.push_back(value); });
+            index.for_each_superset_of(query, [&](const size_t value) { supersets.push_back(value); });
+            std::sort(subsets.begin(), subsets.end());
+            std::sort(supersets.begin(), supersets.end());
+            CHECK(subsets == expected_subsets);
+            CHECK(supersets == expected_supersets);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include <catch2/catch.hpp>
+
+#include "mata/utils/worklist.hh"
+
+using namespace mata::utils;
+
+namespace {
+    std::vector<int> pop_all(Worklist<int>& worklist) {
+        std::vector<int> result;
+        while (!worklist.empty()) { result.push_back(worklist.pop()); }
+        return result;
+    }
+}
+
+TEST_CASE("mata::utils::Worklist") {
+    SECTION("DFS") {
+        Worklist<int> worklist{ WorklistOrder::DFS };
+        for (int i{ 0 }; i < 4; ++i) { worklist.push(i, static_cast<size_t>(4 - i)); }
+        CHECK(worklist.size() == 4);
+        CHECK(pop_all(worklist) == std::vector<int>{ 3, 2, 1, 0 });
+    }
+
+    SECTION("BFS") {
+        Worklist<int> worklist{ WorklistOrder::BFS };
+        for (int i{ 0 }; i < 4; ++i) { worklist.push(i, static_cast<size_t>(4 - i)); }
+        CHECK(pop_all(worklist) == std::vector<int>{ 0, 1, 2, 3 });
+    }
+
+    SECTION("PRIORITY") {
+        Worklist<int> worklist{ WorklistOrder::PRIORITY };
+        worklist.push(0, 5);
+        worklist.push(1, 2);
+        worklist.push(2, 7);
+        worklist.push(3, 2);
+        CHECK(worklist.pop() == 3);
+        worklist.push(4, 0);
+        CHECK(pop_all(worklist) == std::vector<int>{ 4, 1, 0, 2 });
+    }
+
+    SECTION("steal") {
+        Worklist<int> dfs{ WorklistOrder::DFS };
+        Worklist<int> priority{ WorklistOrder::PRIORITY };
+        for (int i{ 0 }; i < 4; ++i) {
+            dfs.push(i);
+            priority.push(i, static_cast<size_t>(4 - i));
+        }
+        CHECK(dfs.steal() == 0);
+        CHECK(pop_all(dfs) == std::vector<int>{ 3, 2, 1 });
+        CHECK(priority.steal() == 3);
+    }
+}